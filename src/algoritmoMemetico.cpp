@@ -0,0 +1,52 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make algoritmoMemetico
+    Ejecutar: ./algoritmoMemetico datos/file.txt semilla [generaciones] [hilos] [--maxmin]
+    Fecha: 19/10/2026
+
+    Algoritmo memetico estacionario: el algoritmo esta en libmdp (src/mdp/memetic.h). Por defecto 50
+    generaciones y un hilo por nucleo; el resultado no depende del numero de hilos
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    // Las opciones "--" (p. ej. --maxmin) pueden ir en cualquier posicion
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 3){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    // Leemos los datos del problema
+    shared_ptr<const Instance> data = Instance::load(args[1]);
+    if(!data){
+        cout << "Error: No se puede leer " << args[1] << endl;
+        return 1;
+    }
+
+    // Reetiquetamos para que los elementos que mas aportan queden juntos en memoria
+    data = data->reorder();
+
+    options.algorithm = MEMETIC;
+    options.seed = stoi(args[2]);
+    options.starts = args.size() > 3 ? stoi(args[3]) : 50;
+    options.threads = args.size() > 4 ? stoi(args[4]) : (int) thread::hardware_concurrency();
+
+    Solver solver(data, options);
+    Result result = solver.solve();
+
+    cout << result.value << "\t" << result.microseconds << endl;
+    cerr << "evaluaciones: " << result.evaluations << " sin mirar: " << result.skipped << endl;
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make busquedaVecindarioVariable
+    Ejecutar: ./busquedaVecindarioVariable datos/file.txt semilla [iteraciones] [--maxmin]
+    Fecha: 19/10/2026
+
+    Busqueda de Vecindario Variable: el algoritmo esta en libmdp (src/mdp). Por defecto hace las
+    mismas iteraciones que la busqueda local reiterada (10)
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    // Las opciones "--" (p. ej. --maxmin) pueden ir en cualquier posicion
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 3){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    // Leemos los datos del problema
+    shared_ptr<const Instance> data = Instance::load(args[1]);
+    if(!data){
+        cout << "Error: No se puede leer " << args[1] << endl;
+        return 1;
+    }
+
+    // Reetiquetamos para que los elementos que mas aportan queden juntos en memoria
+    data = data->reorder();
+
+    options.algorithm = VARIABLE_NEIGHBORHOOD;
+    options.seed = stoi(args[2]);
+
+    if(args.size() > 3){
+        options.starts = stoi(args[3]);
+    }
+
+    Solver solver(data, options);
+    Result result = solver.solve();
+
+    cout << result.value << "\t" << result.microseconds << endl;
+    cerr << "evaluaciones: " << result.evaluations << " sin mirar: " << result.skipped << " cache: " << result.cacheHits << "/" << result.cacheLookups << " aciertos" << endl;
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: g++ -O2 -o clienteMDP clienteMDP.cpp
+    Ejecutar: ./clienteMDP /tmp/mdp.sock < trabajos.txt
+    Fecha: 19/10/2026
+
+    Cliente sencillo de servidorMDP: envia al socket los trabajos de la entrada estandar
+    (una linea por trabajo) y muestra las respuestas segun van llegando.
+*/
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+
+int main(int argc, char const *argv[])
+{
+    if(argc < 2){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    string path = argv[1];
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if(fd < 0 || path.size() >= sizeof(addr.sun_path)){
+        cout << "Error: Socket invalido" << endl;
+        return 1;
+    }
+    path.copy(addr.sun_path, path.size());
+
+    if(connect(fd, (sockaddr *) &addr, sizeof(addr)) < 0){
+        cout << "Error: No se puede conectar a " << path << endl;
+        return 1;
+    }
+
+    // Enviamos todos los trabajos y cerramos la escritura para que el servidor sepa que no hay mas
+    string line;
+    while(getline(cin, line)){
+        line += "\n";
+        if(write(fd, line.data(), line.size()) < 0){
+            break;
+        }
+    }
+    shutdown(fd, SHUT_WR);
+
+    // El servidor cierra la conexion cuando ha respondido todos los trabajos
+    char buffer[4096];
+    ssize_t bytes;
+    while((bytes = read(fd, buffer, sizeof(buffer))) > 0){
+        cout.write(buffer, bytes);
+        cout.flush();
+    }
+
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make convergencia
+    Ejecutar: ./convergencia semillas datos/file.txt... [--guardar=base.txt | --comparar=base.txt] [--trazas=trazas.csv] [--maxmin]
+    Fecha: 19/10/2026
+
+    Convergencia de los cuatro algoritmos de la practica: ejecuta cada uno con las semillas 1..semillas
+    en cada fichero y guarda la traza de la mejor solucion en el tiempo. Para cada objetivo (un
+    porcentaje del mejor valor conocido del fichero) escribe la mediana del tiempo hasta alcanzarlo:
+
+        fichero algoritmo objetivo mediana_us aciertos/semillas
+
+    --guardar escribe ademas esa tabla y los mejores valores como referencia; --comparar usa los
+    mejores valores de la referencia y termina con error si alguna mediana empeora mas de la
+    tolerancia. --trazas escribe las trazas completas en CSV.
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include "mdp/mdp.h"
+
+#define TOLERANCE 0.25      // Empeoramiento relativo de la mediana que se admite al comparar
+#define SLACK_US 2000       // Y absoluto, para que el ruido en tiempos muy cortos no cuente
+
+using namespace std;
+using namespace std::chrono;
+using namespace mdp;
+
+// Objetivos: fraccion del mejor valor conocido
+const vector<double> targets = {0.98, 0.99, 0.995, 1.0};
+
+// Algoritmos de los cuatro ejecutables, con sus opciones por defecto
+const vector<string> algorithms = {"busquedaMultiBasica", "busquedaLocalReiterada", "busquedaLocalReiterada-ES", "enfriamientoSimulado"};
+
+// Guarda cuando se alcanza cada nuevo mejor valor, en us desde el inicio
+class traceRecorder : public Progress
+{
+    private:
+    steady_clock::time_point start;
+    mutex mtx;
+
+    public:
+    vector<pair<long long, double>> points;
+
+    traceRecorder():start(steady_clock::now()) {}
+
+    //Empieza a contar el tiempo desde ahora
+    void restart()
+    {
+        start = steady_clock::now();
+        points.clear();
+    }
+
+    void improved(double value)
+    {
+        long long us = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+        lock_guard<mutex> lock(mtx);
+        if(points.empty() || value > points.back().second){
+            points.push_back({us, value});
+        }
+    }
+
+    //Tiempo hasta alcanzar target, -1 si no se alcanza
+    long long timeTo(double target) const
+    {
+        for(const pair<long long, double> &p : points){
+            if(p.second >= target){
+                return p.first;
+            }
+        }
+        return -1;
+    }
+};
+
+// Mediana de los tiempos, contando los no alcanzados (-1) como infinito. -1 si la mediana es infinita
+long long median(vector<long long> times)
+{
+    for(long long &t : times){
+        if(t < 0){
+            t = __LONG_LONG_MAX__;
+        }
+    }
+    sort(times.begin(), times.end());
+
+    long long t = times[(times.size() - 1) / 2];
+    return t == __LONG_LONG_MAX__ ? -1 : t;
+}
+
+string formatTime(long long t)
+{
+    return t < 0 ? "inf" : to_string(t);
+}
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    string savePath, comparePath, tracePath;
+    vector<string> files;
+
+    for(size_t k=2; k < args.size(); k++){
+        if(args[k].compare(0, 10, "--guardar=") == 0){
+            savePath = args[k].substr(10);
+        }else if(args[k].compare(0, 11, "--comparar=") == 0){
+            comparePath = args[k].substr(11);
+        }else if(args[k].compare(0, 9, "--trazas=") == 0){
+            tracePath = args[k].substr(9);
+        }else{
+            files.push_back(args[k]);
+        }
+    }
+
+    if(args.size() < 3 || files.empty()){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    int seeds = stoi(args[1]);
+
+    // Referencia: mejores valores por fichero y mediana por fichero, algoritmo y objetivo
+    map<string, double> bestKnown;
+    map<string, long long> baseline;
+    map<string, bool> fixedBest;
+
+    if(!comparePath.empty()){
+        ifstream base(comparePath);
+        if(!base.is_open()){
+            cout << "Error: No se puede leer " << comparePath << endl;
+            return 1;
+        }
+
+        string line, kind, file, algorithm, time;
+        while(getline(base, line)){
+            istringstream fields(line);
+            fields >> kind >> file;
+            if(kind == "mejor"){
+                fields >> bestKnown[file];
+                fixedBest[file] = true;
+            }else if(kind == "ttt"){
+                double target;
+                fields >> algorithm >> target >> time;
+                baseline[file + " " + algorithm + " " + to_string(target)] = time == "inf" ? -1 : stoll(time);
+            }
+        }
+    }
+
+    ofstream traces;
+    if(!tracePath.empty()){
+        traces.open(tracePath);
+        traces << "fichero,algoritmo,semilla,tiempo_us,valor" << endl;
+    }
+
+    ostringstream table;
+    bool regression = false;
+
+    for(const string &file : files){
+        shared_ptr<const Instance> data = Instance::load(file);
+        if(!data){
+            cout << "Error: No se puede leer " << file << endl;
+            return 1;
+        }
+
+        // Como los ejecutables
+        data = data->reorder();
+
+        // Todas las ejecuciones del fichero, para conocer el mejor valor antes de medir los tiempos
+        map<string, vector<traceRecorder>> runs;
+
+        for(const string &name : algorithms){
+            runs[name] = vector<traceRecorder>(seeds);
+
+            for(int s=0; s < seeds; s++){
+                Options run = options;
+                parseAlgorithm(name, run.algorithm);
+                run.seed = s + 1;
+                run.progress = &runs[name][s];
+
+                runs[name][s].restart();
+                Result result = Solver(data, run).solve();
+                runs[name][s].improved(result.value);
+
+                // Al comparar los objetivos salen de los mejores valores de la referencia
+                if(!fixedBest.count(file) && (!bestKnown.count(file) || result.value > bestKnown[file])){
+                    bestKnown[file] = result.value;
+                }
+
+                for(const pair<long long, double> &p : runs[name][s].points){
+                    if(traces.is_open()){
+                        traces << file << "," << name << "," << s + 1 << "," << p.first << "," << p.second << "\n";
+                    }
+                }
+            }
+        }
+
+        table << "mejor\t" << file << "\t" << setprecision(17) << bestKnown[file] << setprecision(6) << "\n";
+
+        for(const string &name : algorithms){
+            for(double target : targets){
+                vector<long long> times;
+                int hits = 0;
+                for(const traceRecorder &trace : runs[name]){
+                    times.push_back(trace.timeTo(target * bestKnown[file]));
+                    hits += times.back() >= 0;
+                }
+
+                long long t = median(times);
+                cout << file << "\t" << name << "\t" << target << "\t" << formatTime(t) << "\t" << hits << "/" << seeds << endl;
+                table << "ttt\t" << file << "\t" << name << "\t" << target << "\t" << formatTime(t) << "\t" << hits << "\n";
+
+                // Empeora si no se alcanza cuando antes si, o si tarda mas de la tolerancia
+                string key = file + " " + name + " " + to_string(target);
+                if(baseline.count(key)){
+                    long long base = baseline[key];
+                    bool worse = base >= 0 && (t < 0 || t > base * (1 + TOLERANCE) + SLACK_US);
+                    if(worse){
+                        cout << "REGRESION: " << file << " " << name << " " << target << ": " << formatTime(t) << " us frente a " << base << " us" << endl;
+                        regression = true;
+                    }
+                }
+            }
+        }
+    }
+
+    if(!savePath.empty()){
+        ofstream base(savePath);
+        base << table.str();
+    }
+
+    return regression ? 1 : 0;
+}
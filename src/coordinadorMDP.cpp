@@ -0,0 +1,508 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make coordinadorMDP
+    Ejecutar: ./coordinadorMDP datos/file.txt algoritmo semilla procesos [tareas] [presupuesto]
+    Fecha: 19/10/2026
+
+    Resolucion repartida entre varios procesos de la misma maquina. El coordinador lanza los
+    procesos trabajadores (conectados con un socketpair cada uno) y les reparte tareas:
+
+        TAREA fichero algoritmo semilla inicio presupuesto
+
+    inicio es el indice de arranque: en busquedaMultiBasica cada tarea es un arranque de la
+    multiarranque (por defecto 10 tareas, el mismo resultado que el ejecutable con esa semilla); en el
+    resto cada tarea es una ejecucion completa con la semilla de ese arranque (por defecto una por
+    proceso). Los trabajadores leen cada fichero una sola vez y responden
+
+        MEJOR valor e1 ... em                      (cada vez que mejoran, durante la tarea)
+        RESULTADO inicio valor evaluaciones e1 ... em
+
+    El coordinador reenvia cada MEJOR que supera la mejor conocida al resto de trabajadores, y las
+    reiteradas continuan desde ella. Al final escribe "valor\ttiempo" como los demas ejecutables.
+*/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <chrono>
+
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace mdp;
+
+// Extremo de la conexion entre coordinador y trabajador: mensajes de una linea
+class channel
+{
+    private:
+    int fd;
+
+    //Datos leidos que aun no forman una linea completa
+    string buffer;
+
+    public:
+    bool eof;
+
+    channel(int fd):fd(fd), eof(false) {}
+
+    int getFd() const { return fd; }
+
+    //Devuelve la siguiente linea. Si wait es false y no hay una linea completa disponible devuelve false
+    bool readLine(string &line, bool wait);
+
+    void send(const string &line);
+};
+
+// Cooperacion de un trabajador: publica sus mejoras al coordinador y recoge las que este reenvia
+class processCooperation : public Cooperation
+{
+    private:
+    channel &chan;
+
+    //Mejor solucion conocida (propia o recibida) de la tarea actual
+    double known;
+    vector<int> knownSolution;
+
+    //Hay una solucion recibida que la busqueda aun no ha recogido
+    bool received;
+
+    public:
+    //Lineas que no son MEJOR y llegan durante una tarea (la siguiente TAREA o FIN)
+    deque<string> pending;
+
+    processCooperation(channel &chan):chan(chan), known(-1.0), received(false) {}
+
+    //Empieza una tarea nueva: se olvida la mejor conocida
+    void reset();
+
+    //Lee los mensajes disponibles sin bloquear
+    void drain();
+
+    //Procesa una linea MEJOR. Devuelve false si la linea es otro mensaje
+    bool parseBest(const string &line);
+
+    void publish(double value, const vector<int> &solution);
+
+    bool receive(double &value, vector<int> &solution);
+};
+
+struct task
+{
+    int start;
+    double value;
+    vector<int> solution;
+};
+
+string formatSolution(double value, const vector<int> &solution);
+int runWorker(int fd);
+
+int main(int argc, char const *argv[])
+{
+    if(argc < 5){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    string path = argv[1];
+    string algorithmName = argv[2];
+    unsigned int seed = stoul(argv[3]);
+    int processes = stoi(argv[4]);
+
+    Algorithm algorithm;
+    if(!parseAlgorithm(algorithmName, algorithm)){
+        cout << "Error: Algoritmo desconocido " << algorithmName << endl;
+        return 1;
+    }
+
+    shared_ptr<const Instance> data = Instance::load(path);
+    if(!data){
+        cout << "Error: No se puede leer " << path << endl;
+        return 1;
+    }
+
+    if(processes < 1){
+        processes = 1;
+    }
+
+    int tasks = argc > 5 ? stoi(argv[5]) : (algorithm == MULTI_START ? 10 : processes);
+    int budget = argc > 6 ? stoi(argv[6]) : 0;
+
+    signal(SIGPIPE, SIG_IGN);
+
+    // Cronometramos todo el reparto, incluido el arranque de los procesos
+    auto start = high_resolution_clock::now();
+
+    vector<channel> workers;
+    vector<pid_t> pids;
+
+    for(int p=0; p < processes; p++){
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0){
+            cout << "Error: No se puede crear la conexion con los trabajadores" << endl;
+            return 1;
+        }
+
+        pid_t pid = fork();
+        if(pid == 0){
+            // El trabajador solo conserva su extremo de la conexion
+            close(fds[0]);
+            for(channel &other : workers){
+                close(other.getFd());
+            }
+            _exit(runWorker(fds[1]));
+        }
+
+        close(fds[1]);
+        workers.emplace_back(fds[0]);
+        pids.push_back(pid);
+    }
+
+    deque<int> queue;
+    for(int k=0; k < tasks; k++){
+        queue.push_back(k);
+    }
+
+    vector<int> assigned(processes, -1);
+    double globalValue = -1.0;
+    vector<int> globalSolution;
+    task best = {-1, -1.0, {}};
+    int finished = 0, broadcasts = 0;
+
+    // Da la siguiente tarea al trabajador p (junto con la mejor solucion conocida) o le indica que acabe
+    auto dispatch = [&](int p){
+        if(queue.empty()){
+            assigned[p] = -1;
+            workers[p].send("FIN");
+            return;
+        }
+
+        assigned[p] = queue.front();
+        queue.pop_front();
+
+        ostringstream line;
+        line << "TAREA " << path << " " << algorithmName << " " << seed << " " << assigned[p] << " " << budget;
+        workers[p].send(line.str());
+
+        if(globalValue >= 0){
+            workers[p].send(formatSolution(globalValue, globalSolution));
+        }
+    };
+
+    for(int p=0; p < processes; p++){
+        dispatch(p);
+    }
+
+    while(finished < tasks){
+        vector<pollfd> fds;
+        vector<int> index;
+        for(int p=0; p < processes; p++){
+            if(!workers[p].eof){
+                fds.push_back({workers[p].getFd(), POLLIN, 0});
+                index.push_back(p);
+            }
+        }
+
+        if(fds.empty()){
+            cout << "Error: Todos los trabajadores han terminado antes de acabar las tareas" << endl;
+            return 1;
+        }
+
+        poll(fds.data(), fds.size(), -1);
+
+        for(size_t f=0; f < fds.size(); f++){
+            if(!fds[f].revents){
+                continue;
+            }
+
+            int p = index[f];
+            string line;
+
+            while(workers[p].readLine(line, false)){
+                istringstream message(line);
+                string type;
+                message >> type;
+
+                if(type == "MEJOR"){
+                    double value;
+                    vector<int> solution;
+                    int e;
+
+                    message >> value;
+                    while(message >> e){
+                        solution.push_back(e);
+                    }
+
+                    // Solo se reenvian las que mejoran la mejor conocida
+                    if(value > globalValue){
+                        globalValue = value;
+                        globalSolution = solution;
+
+                        for(int q=0; q < processes; q++){
+                            if(q != p && assigned[q] >= 0){
+                                workers[q].send(line);
+                                broadcasts++;
+                            }
+                        }
+                    }
+                }else if(type == "RESULTADO"){
+                    task result;
+                    long long evaluations;
+                    int e;
+
+                    message >> result.start >> result.value >> evaluations;
+                    while(message >> e){
+                        result.solution.push_back(e);
+                    }
+
+                    // Ante empate nos quedamos con el arranque de menor indice, como la multiarranque
+                    if(result.value > best.value || (result.value == best.value && result.start < best.start)){
+                        best = result;
+                    }
+
+                    finished++;
+                    dispatch(p);
+                }
+            }
+
+            // Si un trabajador muere su tarea vuelve a la cola
+            if(workers[p].eof && assigned[p] >= 0){
+                cerr << "Error: El trabajador " << p << " ha terminado sin acabar la tarea " << assigned[p] << endl;
+                queue.push_front(assigned[p]);
+                assigned[p] = -1;
+
+                for(int q=0; q < processes; q++){
+                    if(!workers[q].eof && assigned[q] < 0){
+                        dispatch(q);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for(int p=0; p < processes; p++){
+        if(assigned[p] >= 0){
+            workers[p].send("FIN");
+        }
+        close(workers[p].getFd());
+        waitpid(pids[p], nullptr, 0);
+    }
+
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+
+    // Recalculamos el valor con el problema del coordinador
+    double value = 0;
+    for(size_t i=0; i < best.solution.size(); i++){
+        for(size_t j=i+1; j < best.solution.size(); j++){
+            value += data->getDistance(best.solution[i], best.solution[j]);
+        }
+    }
+
+    cout << value << "\t" << duration.count() << endl;
+    cerr << "tareas: " << tasks << " procesos: " << processes << " mejoras reenviadas: " << broadcasts << endl;
+
+    return 0;
+}
+
+int runWorker(int fd)
+{
+    channel chan(fd);
+    processCooperation cooperation(chan);
+
+    //Problemas ya leidos por este trabajador
+    map<string, shared_ptr<const Instance>> instances;
+
+    while(true){
+        string line;
+
+        if(!cooperation.pending.empty()){
+            line = cooperation.pending.front();
+            cooperation.pending.pop_front();
+        }else if(!chan.readLine(line, true)){
+            break;
+        }
+
+        istringstream message(line);
+        string type;
+        message >> type;
+
+        if(type == "FIN"){
+            break;
+        }else if(type == "MEJOR"){
+            cooperation.parseBest(line);
+            continue;
+        }else if(type != "TAREA"){
+            continue;
+        }
+
+        string path, algorithmName;
+        Options options;
+        options.starts = 1;
+        message >> path >> algorithmName >> options.seed >> options.firstStart >> options.budget;
+        parseAlgorithm(algorithmName, options.algorithm);
+
+        // En la multiarranque cada tarea es un arranque; en el resto una ejecucion completa
+        if(options.algorithm != MULTI_START){
+            options.starts = Options().starts;
+        }
+
+        if(!instances.count(path)){
+            shared_ptr<const Instance> data = Instance::load(path);
+            instances[path] = data ? data->reorder() : data;
+        }
+
+        cooperation.reset();
+        options.cooperation = &cooperation;
+
+        Result result = Solver(instances[path], options).solve();
+
+        ostringstream out;
+        out.precision(17);
+        out << "RESULTADO " << options.firstStart << " " << result.value << " " << result.evaluations;
+        for(int e : result.solution){
+            out << " " << e;
+        }
+        chan.send(out.str());
+    }
+
+    close(fd);
+
+    return 0;
+}
+
+string formatSolution(double value, const vector<int> &solution)
+{
+    ostringstream line;
+    line.precision(17);
+    line << "MEJOR " << value;
+    for(int e : solution){
+        line << " " << e;
+    }
+
+    return line.str();
+}
+
+void processCooperation::reset()
+{
+    known = -1.0;
+    knownSolution.clear();
+    received = false;
+}
+
+void processCooperation::drain()
+{
+    string line;
+
+    while(chan.readLine(line, false)){
+        if(!parseBest(line)){
+            pending.push_back(line);
+        }
+    }
+}
+
+bool processCooperation::parseBest(const string &line)
+{
+    istringstream message(line);
+    string type;
+    double value;
+    message >> type;
+
+    if(type != "MEJOR"){
+        return false;
+    }
+
+    message >> value;
+    if(value > known){
+        known = value;
+        knownSolution.clear();
+        int e;
+        while(message >> e){
+            knownSolution.push_back(e);
+        }
+        received = true;
+    }
+
+    return true;
+}
+
+void processCooperation::publish(double value, const vector<int> &solution)
+{
+    drain();
+
+    // Lo que no mejora la mejor conocida no le sirve a nadie
+    if(value > known){
+        known = value;
+        knownSolution = solution;
+        received = false;
+        chan.send(formatSolution(value, solution));
+    }
+}
+
+bool processCooperation::receive(double &value, vector<int> &solution)
+{
+    drain();
+
+    if(!received || known <= value){
+        return false;
+    }
+
+    received = false;
+    value = known;
+    solution = knownSolution;
+
+    return true;
+}
+
+bool channel::readLine(string &line, bool wait)
+{
+    while(true){
+        size_t end = buffer.find('\n');
+        if(end != string::npos){
+            line = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            return true;
+        }
+
+        if(eof){
+            return false;
+        }
+
+        if(!wait){
+            pollfd pfd = {fd, POLLIN, 0};
+            if(poll(&pfd, 1, 0) <= 0){
+                return false;
+            }
+        }
+
+        char data[4096];
+        ssize_t bytes = read(fd, data, sizeof(data));
+        if(bytes <= 0){
+            eof = true;
+            return false;
+        }
+        buffer.append(data, bytes);
+    }
+}
+
+void channel::send(const string &line)
+{
+    string out = line + "\n";
+    size_t sent = 0;
+
+    while(sent < out.size()){
+        ssize_t bytes = write(fd, out.data() + sent, out.size() - sent);
+        if(bytes <= 0){
+            break;
+        }
+        sent += bytes;
+    }
+}
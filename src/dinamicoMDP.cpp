@@ -0,0 +1,139 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make dinamicoMDP
+    Ejecutar: ./dinamicoMDP datos/file.txt semilla [algoritmo] [--maxmin] < cambios.txt
+    Fecha: 19/10/2026
+
+    Problema dinamico: resuelve el fichero y despues lee cambios de la entrada estandar, uno por linea
+    (con las etiquetas del fichero):
+        + etiqueta [j distancia]...     anade un elemento con sus distancias (las que faltan son 0)
+        - etiqueta                      quita un elemento
+        = i j distancia                 cambia una distancia
+    Una linea vacia (o el final de la entrada) aplica los cambios leidos y vuelve a resolver partiendo
+    de la solucion anterior. Por cada resolucion escribe "valor tiempo n", con el tiempo de aplicar los
+    cambios y resolver en us. El algoritmo por defecto es busquedaLocal.
+*/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace mdp;
+
+// Lee una linea de cambio y la anade a delta. Devuelve false si no tiene el formato
+bool parseChange(const string &line, Delta &delta)
+{
+    istringstream in(line);
+    string op;
+    in >> op;
+
+    if(op == "+"){
+        Delta::Element element;
+        if(!(in >> element.label)){
+            return false;
+        }
+
+        int j;
+        double distance;
+        while(in >> j >> distance){
+            element.distances.push_back({j, distance});
+        }
+
+        delta.added.push_back(element);
+    }else if(op == "-"){
+        int label;
+        if(!(in >> label)){
+            return false;
+        }
+
+        delta.removed.push_back(label);
+    }else if(op == "="){
+        Delta::Change change;
+        if(!(in >> change.i >> change.j >> change.distance)){
+            return false;
+        }
+
+        delta.changed.push_back(change);
+    }else{
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    options.algorithm = LOCAL_SEARCH;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 3){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    if(args.size() > 3 && !parseAlgorithm(args[3], options.algorithm)){
+        cout << "Error: Algoritmo desconocido " << args[3] << endl;
+        return 1;
+    }
+
+    // El problema se modifica en su sitio, asi que no es const
+    shared_ptr<Instance> data = Instance::load(args[1]);
+    if(!data){
+        cout << "Error: No se puede leer " << args[1] << endl;
+        return 1;
+    }
+
+    // Reetiquetamos para que los elementos que mas aportan queden juntos en memoria
+    data = data->reorder();
+
+    options.seed = stoi(args[2]);
+
+    Result result = Solver(data, options).solve();
+    cout << result.value << "\t" << result.microseconds << "\t" << data->getN() << endl;
+
+    Delta delta;
+    string line;
+    bool end = false;
+
+    while(!end){
+        end = !getline(cin, line);
+
+        if(!end && !line.empty()){
+            if(!parseChange(line, delta)){
+                cout << "Error: Cambio invalido " << line << endl;
+            }
+            continue;
+        }
+
+        if(delta.empty()){
+            continue;
+        }
+
+        auto start = high_resolution_clock::now();
+
+        if(!data->apply(delta)){
+            cout << "Error: No se pueden aplicar los cambios" << endl;
+            delta = Delta();
+            continue;
+        }
+
+        // Partimos de la solucion anterior y la primera busqueda local solo mira lo que ha cambiado
+        options.start = result.solution;
+        options.changed = delta.labels();
+        result = Solver(data, options).solve();
+
+        auto stop = high_resolution_clock::now();
+
+        cout << result.value << "\t" << duration_cast<microseconds>(stop - start).count() << "\t" << data->getN() << endl;
+        cerr << "evaluaciones: " << result.evaluations << endl;
+
+        delta = Delta();
+    }
+
+    return 0;
+}
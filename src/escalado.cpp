@@ -0,0 +1,179 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make escalado
+    Ejecutar: ./escalado semilla [n_max] [m] [uniforme|euclidea|agrupada] [--maxmin]
+    Fecha: 19/10/2026
+
+    Escalado de los algoritmos con n: genera problemas de n = 500, 1000, 2000, 5000, 10000 y 20000
+    (hasta n_max, por defecto 20000) con m elementos (por defecto 50) y ejecuta cada algoritmo con sus
+    opciones por defecto. Por cada ejecucion escribe
+
+        n algoritmo valor tiempo_us us_por_evaluacion memoria_MB fallos_cache
+
+    La memoria es el pico de memoria residente del proceso durante la ejecucion (el problema incluido:
+    n*n*8 bytes) y los fallos de cache salen de los contadores del procesador; si el sistema no los
+    da se escribe "-". Los problemas no se reetiquetan para que quepan una sola vez en memoria.
+*/
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+const vector<int> sizes = {500, 1000, 2000, 5000, 10000, 20000};
+
+// Algoritmos de los ejecutables (las exactas no llegan a estos tamanios)
+const vector<string> algorithms = {"greedy", "busquedaMultiBasica", "busquedaLocalReiterada", "busquedaLocalReiterada-ES",
+                                   "enfriamientoSimulado", "algoritmoMemetico", "busquedaVecindarioVariable"};
+
+// Fallos de cache del proceso con perf_event_open. Si no hay contadores (maquina virtual,
+// perf_event_paranoid) available() es false
+class cacheMissCounter
+{
+    private:
+    int fd;
+
+    public:
+    cacheMissCounter()
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    ~cacheMissCounter()
+    {
+        if(fd >= 0){
+            close(fd);
+        }
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start()
+    {
+        if(fd >= 0){
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    long long stop()
+    {
+        long long count = -1;
+        if(fd >= 0){
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if(read(fd, &count, sizeof(count)) != sizeof(count)){
+                count = -1;
+            }
+        }
+        return count;
+    }
+};
+
+// Reinicia el pico de memoria residente del proceso (Linux >= 4.0)
+void resetPeakMemory()
+{
+    ofstream("/proc/self/clear_refs") << "5";
+}
+
+// Pico de memoria residente desde el ultimo reinicio, en MB
+double peakMemory()
+{
+    ifstream status("/proc/self/status");
+    string line;
+
+    while(getline(status, line)){
+        if(line.compare(0, 6, "VmHWM:") == 0){
+            return stod(line.substr(6)) / 1024;
+        }
+    }
+
+    return -1;
+}
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 2){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    options.seed = stoi(args[1]);
+    int maxN = args.size() > 2 ? stoi(args[2]) : sizes.back();
+    int m = args.size() > 3 ? stoi(args[3]) : 50;
+
+    Distribution distribution = UNIFORM_DISTANCES;
+    if(args.size() > 4){
+        if(args[4] == "euclidea"){
+            distribution = EUCLIDEAN_DISTANCES;
+        }else if(args[4] == "agrupada"){
+            distribution = CLUSTERED_DISTANCES;
+        }else if(args[4] != "uniforme"){
+            cout << "Error: Distribucion desconocida " << args[4] << endl;
+            return 1;
+        }
+    }
+
+    cacheMissCounter misses;
+
+    cout << "n\talgoritmo\tvalor\ttiempo_us\tus_por_evaluacion\tmemoria_MB\tfallos_cache" << endl;
+
+    for(int n : sizes){
+        if(n > maxN){
+            break;
+        }
+
+        shared_ptr<const Instance> data = Instance::generate(n, m, distribution, options.seed);
+        if(!data){
+            cout << "Error: Tamanio invalido" << endl;
+            return 1;
+        }
+
+        for(const string &name : algorithms){
+            Options run = options;
+            parseAlgorithm(name, run.algorithm);
+
+            resetPeakMemory();
+            misses.start();
+            Result result = Solver(data, run).solve();
+            long long count = misses.stop();
+
+            cout << n << "\t" << name << "\t" << result.value << "\t" << result.microseconds << "\t";
+            if(result.evaluations > 0){
+                cout << (double) result.microseconds / result.evaluations;
+            }else{
+                cout << "-";
+            }
+            cout << "\t" << peakMemory() << "\t";
+            if(count >= 0){
+                cout << count;
+            }else{
+                cout << "-";
+            }
+            cout << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make exacta
+    Ejecutar: ./exacta datos/file.txt [segundos] [hilos]
+    Fecha: 19/10/2026
+
+    Solucion exacta de MaxSum por ramificacion y poda (para n pequenio o mediano, n <= 256): sirve
+    para saber a que distancia del optimo quedan las heuristicas. Con un limite de segundos, si no
+    termina da la mejor solucion encontrada y el hueco con la cota de lo que queda por explorar.
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 2){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    // Leemos los datos del problema
+    shared_ptr<const Instance> data = Instance::load(args[1]);
+    if(!data){
+        cout << "Error: No se puede leer " << args[1] << endl;
+        return 1;
+    }
+
+    // Reetiquetamos: los que mas aportan van primero y dan pronto una buena solucion para podar
+    data = data->reorder();
+
+    options.algorithm = BRANCH_AND_BOUND;
+    options.timeLimit = args.size() > 2 ? stod(args[2]) : 0;
+    options.threads = args.size() > 3 ? stoi(args[3]) : (int) thread::hardware_concurrency();
+
+    Solver solver(data, options);
+    Result result = solver.solve();
+
+    if(result.solution.empty()){
+        cout << "Error: Problema demasiado grande para la solucion exacta" << endl;
+        return 1;
+    }
+
+    cout << result.value << "\t" << result.microseconds << endl;
+    cerr << "cota: " << result.bound << " hueco: " << 100 * (result.bound - result.value) / result.value << "% nodos: " << result.evaluations << endl;
+
+    return 0;
+}
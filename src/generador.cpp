@@ -0,0 +1,64 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make generador
+    Ejecutar: ./generador fichero n m semilla [uniforme|euclidea|agrupada] [--binario]
+    Fecha: 19/10/2026
+
+    Genera un problema sintetico: distancias uniformes en [0, 10] como MDG-a (por defecto), euclideas
+    entre puntos al azar en un cuadrado, o euclideas entre puntos agrupados alrededor de unos centros.
+    Lo escribe con el formato de texto de data/ o, con --binario, en el formato binario de libmdp
+    (mucho mas pequenio y rapido de leer para n grande).
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    // --binario lo quitamos aqui: no es una opcion de libmdp
+    auto binaryFlag = find(args.begin(), args.end(), "--binario");
+    bool binary = binaryFlag != args.end();
+    if(binary){
+        args.erase(binaryFlag);
+    }
+
+    if(args.size() < 5){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    Distribution distribution = UNIFORM_DISTANCES;
+    if(args.size() > 5){
+        if(args[5] == "uniforme"){
+            distribution = UNIFORM_DISTANCES;
+        }else if(args[5] == "euclidea"){
+            distribution = EUCLIDEAN_DISTANCES;
+        }else if(args[5] == "agrupada"){
+            distribution = CLUSTERED_DISTANCES;
+        }else{
+            cout << "Error: Distribucion desconocida " << args[5] << endl;
+            return 1;
+        }
+    }
+
+    shared_ptr<Instance> data = Instance::generate(stoi(args[2]), stoi(args[3]), distribution, stoi(args[4]));
+    if(!data){
+        cout << "Error: Tamanio invalido" << endl;
+        return 1;
+    }
+
+    if(!data->save(args[1], binary)){
+        cout << "Error: No se puede escribir " << args[1] << endl;
+        return 1;
+    }
+
+    return 0;
+}
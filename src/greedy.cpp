@@ -0,0 +1,49 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make greedy
+    Ejecutar: ./greedy datos/file.txt semilla [pulir] [--maxmin]
+    Fecha: 19/10/2026
+
+    Greedy determinista (el mas lejano a los elegidos): la semilla no se usa, se acepta para poder
+    lanzarlo igual que el resto. Con pulir = 1 hace una pasada de intercambios de mejora al final
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    // Las opciones "--" (p. ej. --maxmin) pueden ir en cualquier posicion
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 3){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    // Leemos los datos del problema
+    shared_ptr<const Instance> data = Instance::load(args[1]);
+    if(!data){
+        cout << "Error: No se puede leer " << args[1] << endl;
+        return 1;
+    }
+
+    // Reetiquetamos para que los elementos que mas aportan queden juntos en memoria
+    data = data->reorder();
+
+    options.algorithm = GREEDY;
+    options.seed = stoi(args[2]);
+    options.polish = args.size() > 3 && stoi(args[3]) != 0;
+
+    Solver solver(data, options);
+    Result result = solver.solve();
+
+    cout << result.value << "\t" << result.microseconds << endl;
+
+    return 0;
+}
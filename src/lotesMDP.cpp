@@ -0,0 +1,184 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make lotesMDP
+    Ejecutar: ./lotesMDP datos/lote.txt semilla [hilos] [limite] [--maxmin]
+              ./lotesMDP - semilla [hilos] [limite] [--maxmin]          (lote por la entrada estandar)
+    Fecha: 19/10/2026
+
+    Resuelve muchos problemas pequenios en un solo proceso. El lote son problemas con el formato de
+    siempre uno detras de otro: cada linea "n m" empieza un problema nuevo. Se leen por bloques y
+    cada bloque se reparte entre los hilos; si el problema tiene como mucho limite subconjuntos
+    (por defecto 1000000) se resuelve por busqueda exhaustiva y si no por busqueda local.
+
+    Por cada problema escribe, en el orden del lote, "num_problema\tvalor\ttiempo".
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+#include "mdp/mdp.h"
+
+#define BLOCK_SIZE 4096     // Problemas que se leen antes de resolverlos
+
+using namespace std;
+using namespace mdp;
+
+// Lee los problemas de un lote uno a uno. Guarda la cabecera del siguiente al encontrarla
+class batchReader
+{
+    private:
+    istream &in;
+    string header;
+
+    public:
+    batchReader(istream &in):in(in) {}
+
+    //Lee el siguiente problema. Devuelve false al final del lote; data queda a nullptr si no es valido
+    bool next(shared_ptr<const Instance> &data);
+};
+
+bool batchReader::next(shared_ptr<const Instance> &data)
+{
+    string line;
+
+    // Buscamos la cabecera (la primera vez, o si la anterior ya se consumio)
+    while(header.empty() && getline(in, line)){
+        if(line.find_first_not_of(" \t\r") != string::npos){
+            header = line;
+        }
+    }
+    if(header.empty()){
+        return false;
+    }
+
+    int n = 0, m = 0;
+    istringstream(header) >> n >> m;
+    header.clear();
+
+    bool valid = n > 0 && m > 0 && m <= n;
+    vector<double> distances(valid ? (size_t) n * n : 0, 0.0);
+
+    while(getline(in, line)){
+        istringstream fields(line);
+        int i, j;
+        double value;
+
+        if(!(fields >> i >> j)){
+            continue;
+        }
+
+        // Dos campos: cabecera del siguiente problema
+        if(!(fields >> value)){
+            header = line;
+            break;
+        }
+
+        if(i < 0 || j < 0 || i >= n || j >= n){
+            valid = false;
+        }
+        if(valid){
+            distances[(size_t) i * n + j] = value;
+            distances[(size_t) j * n + i] = value;
+        }
+    }
+
+    data = valid ? make_shared<const Instance>(n, m, move(distances)) : nullptr;
+
+    return true;
+}
+
+// C(n,m) sin pasar de limit
+double combinations(int n, int m, double limit)
+{
+    double c = 1;
+
+    for(int k=1; k <= m && c <= limit; k++){
+        c = c * (n - m + k) / k;
+    }
+
+    return c;
+}
+
+int main(int argc, char const *argv[])
+{
+    Options options;
+    vector<string> args = parseArguments(argc, argv, options);
+
+    if(args.size() < 3){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    ifstream file;
+    if(args[1] != "-"){
+        file.open(args[1]);
+        if(!file.is_open()){
+            cout << "Error: No se puede leer " << args[1] << endl;
+            return 1;
+        }
+    }
+    batchReader reader(args[1] == "-" ? cin : file);
+
+    options.seed = stoi(args[2]);
+    int numThreads = args.size() > 3 ? stoi(args[3]) : (int) thread::hardware_concurrency();
+    double limit = args.size() > 4 ? stod(args[4]) : 1e6;
+    numThreads = max(numThreads, 1);
+
+    vector<shared_ptr<const Instance>> block;
+    vector<Result> results;
+    int first = 0;
+    bool end = false;
+
+    while(!end){
+        block.clear();
+
+        shared_ptr<const Instance> data;
+        while(block.size() < BLOCK_SIZE && !(end = !reader.next(data))){
+            block.push_back(data);
+        }
+
+        // Cada hilo coge el siguiente problema del bloque sin resolver
+        results.assign(block.size(), Result());
+        atomic<int> nextInstance(0);
+
+        auto work = [&](){
+            for(int k = nextInstance++; k < (int) block.size(); k = nextInstance++){
+                if(!block[k]){
+                    continue;
+                }
+
+                Options instanceOptions = options;
+                bool small = combinations(block[k]->getN(), block[k]->getM(), limit) <= limit;
+                instanceOptions.algorithm = small ? EXHAUSTIVE : LOCAL_SEARCH;
+
+                results[k] = Solver(block[k], instanceOptions).solve();
+            }
+        };
+
+        vector<thread> workers;
+        for(int w=1; w < numThreads; w++){
+            workers.emplace_back(work);
+        }
+        work();
+        for(thread &worker : workers){
+            worker.join();
+        }
+
+        for(size_t k=0; k < block.size(); k++){
+            if(block[k]){
+                cout << first + k << "\t" << results[k].value << "\t" << results[k].microseconds << "\n";
+            }else{
+                cout << first + k << "\tError: problema invalido\n";
+            }
+        }
+        cout.flush();
+
+        first += block.size();
+    }
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "branchAndBound.h"
+#include "maximumDiversityProblem.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace mdp
+{
+
+int candidateSet::size() const
+{
+    int size = 0;
+    for(int w=0; w < BB_WORDS; w++){
+        size += __builtin_popcountll(words[w]);
+    }
+    return size;
+}
+
+int candidateSet::first() const
+{
+    for(int w=0; w < BB_WORDS; w++){
+        if(words[w]){
+            return w * 64 + __builtin_ctzll(words[w]);
+        }
+    }
+    return -1;
+}
+
+branchAndBound::branchAndBound(const Instance &data, const Options &options):
+    data(data), options(options), n(data.getN()), m(data.getM()), bestValue(-1.0), timeout(false), openBound(-1.0)
+{
+    // Sumas parciales de cada fila ordenada de mayor a menor (solo hacen falta las m-1 primeras)
+    prefix.assign(n, vector<double>(m, 0.0));
+    vector<double> row;
+    for(int i=0; i < n; i++){
+        row.assign(data.getRow(i), data.getRow(i) + n);
+        int k = min(m - 1, n);
+        partial_sort(row.begin(), row.begin() + k, row.end(), greater<double>());
+        for(int t=1; t < m; t++){
+            prefix[i][t] = prefix[i][t-1] + row[t-1];
+        }
+    }
+}
+
+double branchAndBound::bound(worker &w, const candidateSet &candidates, int depth, int r, double value)
+{
+    // Cada par entre los que faltan se cuenta por mitades en sus dos extremos
+    const vector<double> &contribution = w.contribution[depth];
+    w.keys.clear();
+    for(int b=0; b < BB_WORDS; b++){
+        for(unsigned long long bits = candidates.words[b]; bits; bits &= bits - 1){
+            int i = b * 64 + __builtin_ctzll(bits);
+            w.keys.push_back(contribution[i] + 0.5 * prefix[i][r-1]);
+        }
+    }
+
+    nth_element(w.keys.begin(), w.keys.begin() + r - 1, w.keys.end(), greater<double>());
+    for(int k=0; k < r; k++){
+        value += w.keys[k];
+    }
+
+    return value;
+}
+
+void branchAndBound::explore(worker &w, candidateSet candidates, int depth, double value)
+{
+    w.nodes++;
+
+    if(depth == m){
+        offer(value, w.chosen);
+        return;
+    }
+
+    int r = m - depth;
+    if(candidates.size() < r){
+        return;
+    }
+
+    if(w.nodes % BB_CLOCK_NODES == 0 && steady_clock::now() > deadline){
+        timeout = true;
+    }
+
+    // Cada hermano quita un candidato: la cota del resto se recalcula antes de bajar por el
+    for(int j = candidates.first(); j >= 0 && candidates.size() >= r; j = candidates.first()){
+        double b = bound(w, candidates, depth, r, value);
+        if(b <= bestValue.load()){
+            return;
+        }
+
+        if(timeout){
+            lock_guard<mutex> lock(openMtx);
+            openBound = max(openBound, b);
+            return;
+        }
+
+        candidates.erase(j);
+
+        // Contribuciones a los elegidos con j, solo de los candidatos que quedan
+        const double *row = data.getRow(j);
+        const vector<double> &contribution = w.contribution[depth];
+        vector<double> &next = w.contribution[depth+1];
+        for(int k=0; k < BB_WORDS; k++){
+            for(unsigned long long bits = candidates.words[k]; bits; bits &= bits - 1){
+                int i = k * 64 + __builtin_ctzll(bits);
+                next[i] = contribution[i] + row[i];
+            }
+        }
+
+        w.chosen.push_back(j);
+        explore(w, candidates, depth + 1, value + contribution[j]);
+        w.chosen.pop_back();
+    }
+}
+
+void branchAndBound::offer(double value, const vector<int> &chosen)
+{
+    lock_guard<mutex> lock(bestMtx);
+
+    if(value > bestValue.load()){
+        bestValue = value;
+        bestSolution = chosen;
+
+        if(options.progress){
+            options.progress->improved(value);
+        }
+    }
+}
+
+bool branchAndBound::nextTask(int id, task &t)
+{
+    int threads = queues.size();
+
+    // Primero la propia cola por el final; si esta vacia, robamos del principio de las demas
+    for(int k=0; k < threads; k++){
+        taskQueue &q = queues[(id + k) % threads];
+        lock_guard<mutex> lock(q.mtx);
+
+        if(!q.tasks.empty()){
+            if(k == 0){
+                t = move(q.tasks.back());
+                q.tasks.pop_back();
+            }else{
+                t = move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void branchAndBound::run(int id)
+{
+    worker w;
+    w.contribution.assign(m + 1, vector<double>(n, 0.0));
+    w.keys.reserve(n);
+
+    task t;
+
+    while(nextTask(id, t)){
+        // Raiz del subarbol: contribuciones a los elegidos y candidatos posteriores al ultimo
+        candidateSet candidates;
+        double value = 0;
+        vector<double> &contribution = w.contribution[t.chosen.size()];
+        fill(contribution.begin(), contribution.end(), 0.0);
+
+        for(size_t a=0; a < t.chosen.size(); a++){
+            const double *row = data.getRow(t.chosen[a]);
+            value += contribution[t.chosen[a]];
+            for(int i=0; i < n; i++){
+                contribution[i] += row[i];
+            }
+        }
+        for(int i = t.chosen.empty() ? 0 : t.chosen.back() + 1; i < n; i++){
+            candidates.insert(i);
+        }
+
+        w.chosen = t.chosen;
+        explore(w, candidates, t.chosen.size(), value);
+    }
+
+    lock_guard<mutex> lock(openMtx);
+    nodes += w.nodes;
+}
+
+Result branchAndBound::solve()
+{
+    Result result;
+
+    if(n > BB_MAX_N){
+        return result;
+    }
+
+    auto start = steady_clock::now();
+    deadline = options.timeLimit > 0 ? start + duration_cast<steady_clock::duration>(duration<double>(options.timeLimit)) : steady_clock::time_point::max();
+
+    // Solucion de partida de una busqueda local reiterada corta, para podar desde el principio y
+    // para no devolver menos que las heuristicas si se acaba el tiempo
+    maximumDiversityProblem heuristic(data, options, options.seed);
+    heuristic.findIteratedLocalSearch();
+    bestValue = heuristic.getBestValue();
+    bestSolution.assign(heuristic.getBestSolution().begin(), heuristic.getBestSolution().end());
+
+    // Un subarbol por cada par de primeros elementos, repartidos entre las colas
+    int threads = max(options.threads, 1);
+    queues = vector<taskQueue>(threads);
+    int depth = min(m, 2);
+    int k = 0;
+
+    function<void(vector<int>&)> split = [&](vector<int> &chosen){
+        if((int) chosen.size() == depth){
+            queues[k++ % threads].tasks.push_back({chosen});
+            return;
+        }
+        for(int i = chosen.empty() ? 0 : chosen.back() + 1; i <= n - (m - (int) chosen.size()); i++){
+            chosen.push_back(i);
+            split(chosen);
+            chosen.pop_back();
+        }
+    };
+    vector<int> chosen;
+    split(chosen);
+
+    nodes = 0;
+    vector<thread> workers;
+    for(int w=1; w < threads; w++){
+        workers.emplace_back(&branchAndBound::run, this, w);
+    }
+    run(0);
+    for(thread &worker : workers){
+        worker.join();
+    }
+
+    result.microseconds = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    for(int i : bestSolution){
+        result.solution.push_back(data.getLabel(i));
+    }
+    sort(result.solution.begin(), result.solution.end());
+
+    // El valor se recalcula como en el resto de algoritmos (elegidos en orden): sumado por ramas podria
+    // diferir en el redondeo para el mismo subconjunto
+    vector<int> members(bestSolution);
+    sort(members.begin(), members.end());
+    result.value = members.size() == (size_t) m ? kernelsFor(m).evaluate(data, members.data(), m) : bestValue.load();
+    result.bound = timeout ? max(openBound, result.value) : result.value;
+    result.evaluations = nodes;
+
+    return result;
+}
+
+}
@@ -0,0 +1,113 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Ramificacion y poda exacta para MaxSum (uso interno de libmdp). Los candidatos de cada nodo son
+    un conjunto de bits y la cota suma, para los r que faltan, su contribucion a los elegidos mas la
+    mitad de sus r-1 mayores distancias (sumas parciales de las filas ordenadas, precalculadas). Los
+    subarboles de los dos primeros elementos se reparten entre los hilos, cada uno con su cola, y un
+    hilo sin trabajo roba de las colas de los demas.
+*/
+#ifndef MDP_BRANCH_AND_BOUND_H
+#define MDP_BRANCH_AND_BOUND_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "mdp.h"
+
+#define BB_MAX_N 256                    // Mayor n que admite (tamanio de los conjuntos de bits)
+#define BB_WORDS (BB_MAX_N / 64)
+#define BB_CLOCK_NODES 1024             // Nodos entre dos consultas del reloj
+
+namespace mdp
+{
+
+// Conjunto de elementos como bits
+struct candidateSet
+{
+    unsigned long long words[BB_WORDS] = {};
+
+    void insert(int i) { words[i >> 6] |= 1ULL << (i & 63); }
+
+    void erase(int i) { words[i >> 6] &= ~(1ULL << (i & 63)); }
+
+    int size() const;
+
+    //Menor elemento, -1 si esta vacio
+    int first() const;
+};
+
+class branchAndBound
+{
+    private:
+    const Instance &data;
+    const Options &options;
+    int n, m;
+
+    //prefix[i][t]: suma de las t mayores distancias de i
+    std::vector<std::vector<double>> prefix;
+
+    //Subarbol pendiente: los primeros elementos elegidos
+    struct task
+    {
+        std::vector<int> chosen;
+    };
+
+    //Cola de subarboles de cada hilo: saca por el final y los demas le roban por el principio
+    struct taskQueue
+    {
+        std::mutex mtx;
+        std::deque<task> tasks;
+    };
+    std::vector<taskQueue> queues;
+
+    //Estado de cada hilo: elegidos, contribucion de cada elemento a los elegidos por profundidad
+    struct worker
+    {
+        std::vector<int> chosen;
+        std::vector<std::vector<double>> contribution;
+        std::vector<double> keys;
+        long long nodes = 0;
+    };
+
+    //Mejor solucion conocida (el valor se lee sin cerrojo para podar)
+    std::atomic<double> bestValue;
+    std::vector<int> bestSolution;
+    std::mutex bestMtx;
+
+    //Se acabo el tiempo, y mayor cota de los nodos que quedaron sin explorar
+    std::atomic<bool> timeout;
+    double openBound;
+    std::mutex openMtx;
+
+    //Nodos de todos los hilos (cada uno suma los suyos al terminar, con openMtx)
+    long long nodes;
+
+    std::chrono::steady_clock::time_point deadline;
+
+    //Cota del nodo: value mas lo que pueden aportar los r mejores de candidates
+    double bound(worker &w, const candidateSet &candidates, int depth, int r, double value);
+
+    void explore(worker &w, candidateSet candidates, int depth, double value);
+
+    void offer(double value, const std::vector<int> &chosen);
+
+    bool nextTask(int id, task &t);
+
+    void run(int id);
+
+    public:
+
+    branchAndBound(const Instance &data, const Options &options);
+
+    //Resuelve con options.threads hilos y options.timeLimit. Si se acaba el tiempo devuelve la mejor
+    //solucion encontrada y en bound la cota de lo que quedo sin explorar
+    Result solve();
+};
+
+}
+
+#endif
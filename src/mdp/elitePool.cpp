@@ -0,0 +1,50 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include "elitePool.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+bool elitePool::offer(const set<int> &sol, double value, unsigned long long hash)
+{
+    for(const eliteSolution &e : pool){
+        if(e.hash == hash){
+            return false;
+        }
+    }
+
+    if(pool.size() < ELITE_SIZE){
+        pool.push_back({sol, value, hash});
+        return true;
+    }
+
+    // Entre los peores que la nueva, el que mas elementos comparte con ella
+    int replaced = -1, maxShared = -1;
+    for(size_t k=0; k < pool.size(); k++){
+        if(pool[k].value >= value){
+            continue;
+        }
+
+        int shared = 0;
+        for(int i : pool[k].solution){
+            shared += sol.count(i);
+        }
+
+        if(shared > maxShared){
+            maxShared = shared;
+            replaced = k;
+        }
+    }
+
+    if(replaced < 0){
+        return false;
+    }
+
+    pool[replaced] = {sol, value, hash};
+    return true;
+}
+
+}
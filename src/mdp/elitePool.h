@@ -0,0 +1,42 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Conjunto elite de soluciones (uso interno de libmdp) para el reenlazado de caminos. Guarda como
+    mucho ELITE_SIZE soluciones distintas (por hash). Lleno, una solucion nueva solo entra si mejora
+    a alguno y sustituye, entre los que mejora, al que mas elementos comparte con ella: asi el
+    conjunto no se llena de variantes de la misma solucion.
+*/
+#ifndef MDP_ELITE_POOL_H
+#define MDP_ELITE_POOL_H
+
+#include <set>
+#include <vector>
+
+#define ELITE_SIZE 10       // Soluciones del conjunto elite
+
+namespace mdp
+{
+
+struct eliteSolution
+{
+    std::set<int> solution;
+    double value;
+    unsigned long long hash;
+};
+
+class elitePool
+{
+    private:
+    std::vector<eliteSolution> pool;
+
+    public:
+
+    //Propone sol (de valor value y hash hash). Devuelve true si entra
+    bool offer(const std::set<int> &sol, double value, unsigned long long hash);
+
+    const std::vector<eliteSolution> &solutions() const { return pool; }
+};
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <stdlib.h>
+
+#include "frequencyMemory.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+frequencyMemory::frequencyMemory(const Instance &data):data(data), n(data.getN()), counts(n, 0), weights(n), total(0)
+{
+    for(int i=0; i < n; i++){
+        weights[i] = data.getContributionBound(i) + 1e-9;
+        total += weights[i];
+    }
+
+    rebuild();
+}
+
+void frequencyMemory::record(const set<int> &optimum)
+{
+    // Solo cambian los pesos de los elegidos; la suma se mantiene sin recorrer los n
+    for(int i : optimum){
+        counts[i]++;
+        total -= weights[i];
+        weights[i] = (data.getContributionBound(i) + 1e-9) / (1 + counts[i]);
+        total += weights[i];
+    }
+
+    rebuild();
+}
+
+void frequencyMemory::rebuild()
+{
+    probability.assign(n, 0.0);
+    alias.assign(n, 0);
+
+    // Vose: las casillas por debajo de la media se completan con una por encima
+    vector<int> small, large;
+    vector<double> scaled(n);
+    for(int i=0; i < n; i++){
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1 ? small : large).push_back(i);
+    }
+
+    while(!small.empty() && !large.empty()){
+        int s = small.back(), l = large.back();
+        small.pop_back();
+
+        probability[s] = scaled[s];
+        alias[s] = l;
+
+        scaled[l] -= 1 - scaled[s];
+        if(scaled[l] < 1){
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Lo que queda es 1 salvo error de redondeo
+    for(int i : large){
+        probability[i] = 1;
+    }
+    for(int i : small){
+        probability[i] = 1;
+    }
+}
+
+int frequencyMemory::sample(int r1, int r2) const
+{
+    int i = r1 % n;
+    return (double) r2 / ((double) RAND_MAX + 1) < probability[i] ? i : alias[i];
+}
+
+}
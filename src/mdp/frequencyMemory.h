@@ -0,0 +1,53 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Memoria de frecuencias (uso interno de libmdp): cuantas veces ha salido cada elemento en los
+    optimos locales de una ejecucion. Sirve para llevar los arranques y las perturbaciones hacia
+    elementos prometedores (cota de contribucion alta) que aun se han elegido poco: el peso de i es
+    getContributionBound(i) / (1 + veces(i)). Se muestrea en O(1) con el metodo del alias (Vose).
+*/
+#ifndef MDP_FREQUENCY_MEMORY_H
+#define MDP_FREQUENCY_MEMORY_H
+
+#include <set>
+#include <vector>
+
+#include "mdp.h"
+
+namespace mdp
+{
+
+class frequencyMemory
+{
+    private:
+    const Instance &data;
+    int n;
+
+    //Veces que cada elemento ha salido en un optimo y peso con el que se muestrea
+    std::vector<int> counts;
+    std::vector<double> weights;
+    double total;
+
+    //Tabla del alias: la casilla i da i con probabilidad probability[i] y alias[i] en otro caso
+    std::vector<double> probability;
+    std::vector<int> alias;
+
+    //Rehace la tabla con los pesos actuales: O(n)
+    void rebuild();
+
+    public:
+
+    frequencyMemory(const Instance &data);
+
+    //Anota un optimo local: actualiza los pesos de sus m elementos y rehace la tabla
+    void record(const std::set<int> &optimum);
+
+    //Elemento segun los pesos a partir de dos enteros aleatorios en [0, RAND_MAX]: O(1)
+    int sample(int r1, int r2) const;
+
+    int count(int i) const { return counts[i]; }
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Problemas sinteticos para medir como escalan los algoritmos con n (Instance::generate)
+*/
+#include <cmath>
+#include <random>
+
+#include "mdp.h"
+
+#define GENERATOR_SIDE 100.0        // Lado del cuadrado de los puntos
+#define GENERATOR_CLUSTERS 10       // Grupos de la distribucion agrupada
+#define GENERATOR_SPREAD 5.0        // Desviacion tipica de cada grupo
+
+using namespace std;
+
+namespace mdp
+{
+
+shared_ptr<Instance> Instance::generate(int n, int m, Distribution distribution, unsigned int seed)
+{
+    if(n <= 0 || m <= 0 || m > n){
+        return nullptr;
+    }
+
+    mt19937 generator(seed);
+    vector<double> distances((size_t) n * n, 0.0);
+
+    if(distribution == UNIFORM_DISTANCES){
+        uniform_int_distribution<int> cents(0, 1000);
+        for(int i=0; i < n; i++){
+            for(int j=i+1; j < n; j++){
+                double d = cents(generator) / 100.0;
+                distances[(size_t) i * n + j] = d;
+                distances[(size_t) j * n + i] = d;
+            }
+        }
+    }else{
+        // Puntos en el plano: uniformes o alrededor de GENERATOR_CLUSTERS centros
+        uniform_real_distribution<double> side(0, GENERATOR_SIDE);
+        normal_distribution<double> spread(0, GENERATOR_SPREAD);
+        uniform_int_distribution<int> cluster(0, GENERATOR_CLUSTERS - 1);
+
+        vector<double> cx(GENERATOR_CLUSTERS), cy(GENERATOR_CLUSTERS);
+        for(int c=0; c < GENERATOR_CLUSTERS; c++){
+            cx[c] = side(generator);
+            cy[c] = side(generator);
+        }
+
+        vector<double> x(n), y(n);
+        for(int i=0; i < n; i++){
+            if(distribution == EUCLIDEAN_DISTANCES){
+                x[i] = side(generator);
+                y[i] = side(generator);
+            }else{
+                int c = cluster(generator);
+                x[i] = cx[c] + spread(generator);
+                y[i] = cy[c] + spread(generator);
+            }
+        }
+
+        for(int i=0; i < n; i++){
+            for(int j=i+1; j < n; j++){
+                double d = hypot(x[i] - x[j], y[i] - y[j]);
+                distances[(size_t) i * n + j] = d;
+                distances[(size_t) j * n + i] = d;
+            }
+        }
+    }
+
+    return make_shared<Instance>(n, m, move(distances));
+}
+
+}
@@ -0,0 +1,405 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+#include "mdp.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+Instance::Instance(int n, int m, vector<double> distances, vector<int> labels):
+    n(n), m(m), distances(move(distances)), stride(n), labels(move(labels)), upperBound(0)
+{
+    if(this->labels.empty()){
+        for(int i=0; i < n; i++){
+            this->labels.push_back(i);
+        }
+    }
+
+    positions.assign(*max_element(this->labels.begin(), this->labels.end()) + 1, -1);
+    for(int i=0; i < n; i++){
+        positions[this->labels[i]] = i;
+    }
+
+    // Estadisticas por elemento: se calculan una vez y las comparten todas las ejecuciones
+    rowSums.assign(n, 0.0);
+    maxDistances.assign(n, 0.0);
+    topSums.assign(n, 0.0);
+
+    for(int i=0; i < n; i++){
+        computeStats(i);
+    }
+
+    computeUpperBound();
+}
+
+void Instance::computeStats(int i)
+{
+    const double *r = getRow(i);
+    vector<double> row(r, r + n);
+
+    rowSums[i] = maxDistances[i] = topSums[i] = 0;
+
+    for(int j=0; j < n; j++){
+        rowSums[i] += row[j];
+        maxDistances[i] = max(maxDistances[i], row[j]);
+    }
+
+    // Las m-1 mayores distancias de la fila (la diagonal es 0, no molesta)
+    int k = min(m - 1, n);
+    nth_element(row.begin(), row.begin() + k, row.end(), greater<double>());
+    for(int j=0; j < k; j++){
+        topSums[i] += row[j];
+    }
+}
+
+void Instance::computeUpperBound()
+{
+    vector<double> bounds(topSums);
+    int k = min(m, n);
+    nth_element(bounds.begin(), bounds.begin() + k, bounds.end(), greater<double>());
+
+    upperBound = 0;
+    for(int j=0; j < k; j++){
+        upperBound += bounds[j];
+    }
+    upperBound /= 2;
+}
+
+// Formato binario: "MDPB", n y m (int de 32 bits), la mitad superior de la matriz por filas (i < j)
+// en double, sin separadores, y las n etiquetas (int de 32 bits; los ficheros sin ellas usan la posicion)
+static const char binaryMagic[4] = {'M', 'D', 'P', 'B'};
+
+static shared_ptr<Instance> loadBinary(ifstream &file)
+{
+    int n = 0, m = 0;
+    if(!file.read((char *) &n, sizeof(n)) || !file.read((char *) &m, sizeof(m)) || n <= 0 || m <= 0 || m > n){
+        return nullptr;
+    }
+
+    vector<double> distances((size_t) n * n, 0.0);
+    vector<double> row(n);
+
+    for(int i=0; i < n - 1; i++){
+        int count = n - 1 - i;
+        if(!file.read((char *) row.data(), count * sizeof(double))){
+            return nullptr;
+        }
+        for(int k=0; k < count; k++){
+            int j = i + 1 + k;
+            distances[(size_t) i * n + j] = row[k];
+            distances[(size_t) j * n + i] = row[k];
+        }
+    }
+
+    // Etiquetas: si el fichero acaba tras la matriz son las posiciones
+    vector<int> labels(n);
+    if(!file.read((char *) labels.data(), n * sizeof(int))){
+        labels.clear();
+    }else{
+        unordered_set<int> seen;
+        for(int label : labels){
+            if(label < 0 || !seen.insert(label).second){
+                return nullptr;
+            }
+        }
+    }
+
+    return make_shared<Instance>(n, m, move(distances), move(labels));
+}
+
+shared_ptr<Instance> Instance::load(const string &path)
+{
+    ifstream file;
+    file.open(path, ios::binary);
+    if(!file.is_open()){
+        return nullptr;
+    }
+
+    // Si empieza por la marca del formato binario lo leemos de golpe; si no, volvemos al principio
+    char magic[4] = {};
+    if(file.read(magic, 4) && equal(magic, magic + 4, binaryMagic)){
+        return loadBinary(file);
+    }
+    file.clear();
+    file.seekg(0);
+
+    int n = 0, m = 0;
+
+    //Leemos el numero de filas y columnas
+    file >> n >> m;
+    if(n <= 0 || m <= 0 || m > n){
+        return nullptr;
+    }
+
+    //Llenamos la matriz de distancias de 0
+    vector<double> distances((size_t) n * n, 0.0);
+
+    int i, j;
+    double value;
+
+    //Leemos el fichero completo e introducimos los valores a la matriz
+    while(file >> i >> j >> value){
+        if(i < 0 || j < 0 || i >= n || j >= n){
+            return nullptr;
+        }
+        distances[(size_t) i * n + j] = value;
+        distances[(size_t) j * n + i] = value; // Matriz simetrica pq es mas sencillo medir distancias
+    }
+
+    file.close();
+
+    return make_shared<Instance>(n, m, move(distances));
+}
+
+bool Instance::save(const string &path, bool binary) const
+{
+    ofstream file(path, binary ? ios::binary : ios::out);
+    if(!file.is_open()){
+        return false;
+    }
+
+    if(binary){
+        file.write(binaryMagic, 4);
+        file.write((const char *) &n, sizeof(n));
+        file.write((const char *) &m, sizeof(m));
+        for(int i=0; i < n - 1; i++){
+            file.write((const char *) (getRow(i) + i + 1), (n - 1 - i) * sizeof(double));
+        }
+        file.write((const char *) labels.data(), n * sizeof(int));
+    }else{
+        // 10 cifras: las distancias con dos decimales se escriben tal cual
+        file.precision(10);
+        file << n << " " << m << "\n";
+        for(int i=0; i < n; i++){
+            const double *row = getRow(i);
+            for(int j=i+1; j < n; j++){
+                file << i << " " << j << " " << row[j] << "\n";
+            }
+        }
+    }
+
+    return (bool) file;
+}
+
+shared_ptr<Instance> Instance::reorder() const
+{
+    // Nuevo orden: suma de distancias decreciente (ante empate, el orden actual)
+    vector<int> order(n);
+    for(int i=0; i < n; i++){
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [this](int a, int b){ return rowSums[a] > rowSums[b]; });
+
+    vector<double> reordered((size_t) n * n);
+    vector<int> newLabels(n);
+
+    for(int a=0; a < n; a++){
+        const double *row = getRow(order[a]);
+        double *out = reordered.data() + (size_t) a * n;
+        for(int b=0; b < n; b++){
+            out[b] = row[order[b]];
+        }
+        newLabels[a] = labels[order[a]];
+    }
+
+    return make_shared<Instance>(n, m, move(reordered), move(newLabels));
+}
+
+shared_ptr<Instance> Instance::subset(const vector<int> &elements) const
+{
+    int k = elements.size();
+    vector<double> reduced((size_t) k * k);
+    vector<int> newLabels(k);
+
+    for(int a=0; a < k; a++){
+        const double *row = getRow(elements[a]);
+        double *out = reduced.data() + (size_t) a * k;
+        for(int b=0; b < k; b++){
+            out[b] = row[elements[b]];
+        }
+        newLabels[a] = labels[elements[a]];
+    }
+
+    return make_shared<Instance>(k, m, move(reduced), move(newLabels));
+}
+
+vector<int> Delta::labels() const
+{
+    vector<int> labels;
+
+    for(const Element &element : added){
+        labels.push_back(element.label);
+        for(const pair<int, double> &d : element.distances){
+            labels.push_back(d.first);
+        }
+    }
+
+    for(const Change &change : changed){
+        labels.push_back(change.i);
+        labels.push_back(change.j);
+    }
+
+    sort(labels.begin(), labels.end());
+    labels.erase(unique(labels.begin(), labels.end()), labels.end());
+
+    return labels;
+}
+
+void Instance::setDistance(int i, int j, double value)
+{
+    double old = getDistance(i, j);
+
+    distances[(size_t) i * stride + j] = value;
+    distances[(size_t) j * stride + i] = value;
+
+    // Si la distancia crece las m-1 mayores suben como mucho lo mismo; si baja la cota sigue valiendo
+    for(int k : {i, j}){
+        rowSums[k] += value - old;
+        if(value > old){
+            topSums[k] += value - old;
+            maxDistances[k] = max(maxDistances[k], value);
+        }
+    }
+}
+
+void Instance::removeElement(int i)
+{
+    int last = n - 1;
+
+    // Quitar una distancia de una fila no puede subir sus cotas
+    for(int k=0; k < n; k++){
+        rowSums[k] -= getDistance(k, i);
+    }
+
+    positions[labels[i]] = -1;
+
+    if(i != last){
+        for(int k=0; k < n; k++){
+            distances[(size_t) k * stride + i] = getDistance(k, last);
+        }
+        copy(getRow(last), getRow(last) + n, distances.begin() + (size_t) i * stride);
+        distances[(size_t) i * stride + i] = 0;
+
+        labels[i] = labels[last];
+        positions[labels[i]] = i;
+        rowSums[i] = rowSums[last];
+        maxDistances[i] = maxDistances[last];
+        topSums[i] = topSums[last];
+    }
+
+    labels.pop_back();
+    rowSums.pop_back();
+    maxDistances.pop_back();
+    topSums.pop_back();
+    n--;
+}
+
+int Instance::addElement(int label)
+{
+    // Sin sitio: se dobla la reserva, asi el coste de copiar la matriz se reparte entre muchas altas
+    if(n == stride){
+        int newStride = max(2 * stride, 16);
+        vector<double> grown((size_t) newStride * newStride, 0.0);
+        for(int k=0; k < n; k++){
+            copy(getRow(k), getRow(k) + n, grown.begin() + (size_t) k * newStride);
+        }
+        distances.swap(grown);
+        stride = newStride;
+    }
+
+    int i = n++;
+
+    fill(distances.begin() + (size_t) i * stride, distances.begin() + (size_t) i * stride + n, 0.0);
+    for(int k=0; k < n; k++){
+        distances[(size_t) k * stride + i] = 0;
+    }
+
+    labels.push_back(label);
+    if(label >= (int) positions.size()){
+        positions.resize(label + 1, -1);
+    }
+    positions[label] = i;
+
+    rowSums.push_back(0);
+    maxDistances.push_back(0);
+    topSums.push_back(0);
+
+    return i;
+}
+
+bool Instance::apply(const Delta &delta)
+{
+    // Se comprueba todo antes de tocar nada
+    unordered_set<int> removed, added;
+
+    for(int label : delta.removed){
+        if(getPosition(label) < 0 || !removed.insert(label).second){
+            return false;
+        }
+    }
+
+    for(const Delta::Element &element : delta.added){
+        bool exists = getPosition(element.label) >= 0 && !removed.count(element.label);
+        if(element.label < 0 || exists || !added.insert(element.label).second){
+            return false;
+        }
+    }
+
+    auto present = [&](int label){
+        return added.count(label) || (getPosition(label) >= 0 && !removed.count(label));
+    };
+
+    for(const Delta::Element &element : delta.added){
+        for(const pair<int, double> &d : element.distances){
+            if(d.first == element.label || !present(d.first)){
+                return false;
+            }
+        }
+    }
+
+    for(const Delta::Change &change : delta.changed){
+        if(change.i == change.j || !present(change.i) || !present(change.j)){
+            return false;
+        }
+    }
+
+    if(n - (int) removed.size() + (int) added.size() < m){
+        return false;
+    }
+
+    for(int label : delta.removed){
+        removeElement(getPosition(label));
+    }
+
+    for(const Delta::Element &element : delta.added){
+        addElement(element.label);
+    }
+
+    for(const Delta::Element &element : delta.added){
+        for(const pair<int, double> &d : element.distances){
+            setDistance(getPosition(element.label), getPosition(d.first), d.second);
+        }
+    }
+
+    for(const Delta::Change &change : delta.changed){
+        setDistance(getPosition(change.i), getPosition(change.j), change.distance);
+    }
+
+    // Estadisticas exactas para los elementos nombrados; el resto se queda con las cotas
+    for(int label : delta.labels()){
+        computeStats(getPosition(label));
+    }
+
+    computeUpperBound();
+
+    return true;
+}
+
+}
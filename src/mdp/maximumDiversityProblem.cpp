@@ -0,0 +1,1533 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "maximumDiversityProblem.h"
+#include "simd.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+unsigned int seedFor(unsigned int seed, int k)
+{
+    return seed + (unsigned int) k * 2654435761u;
+}
+
+maximumDiversityProblem::maximumDiversityProblem(const Instance &data, const Options &options, unsigned int seed):
+    data(data), n(data.getN()), m(data.getM()), options(options), bestValue(-1.0), seed(seed),
+    tracker(data), selection(data), kernels(kernelsFor(m)), frequencies(data), focused(false), ring(nullptr), profiler(options.profile ? new Profiler() : nullptr), scanThreads(1), passes(0), evaluations(0), skipped(0), cacheLookups(0), cacheHits(0)
+{
+    threshold.assign(n, HUGE_VAL);
+    checked.assign(n, 0);
+
+    //Claves de Zobrist con splitmix64 y semilla fija, para no consumir numeros del generador
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    zobrist.resize(n);
+    for(int k=0; k < n; k++){
+        unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        zobrist[k] = z ^ (z >> 31);
+    }
+}
+
+int maximumDiversityProblem::random()
+{
+    return rand_r(&seed);
+}
+
+void maximumDiversityProblem::reseed(unsigned int seed)
+{
+    this->seed = seed;
+}
+
+set<int> maximumDiversityProblem::findRandomLocalSearchSolution()
+{
+    const int maxIter = options.budget > 0 ? options.budget : 100000;
+
+    set<int> solution = options.start.empty() ? randomSolution() : warmSolution();
+    double solutionValue = 0;
+    unsigned long long hash = hashSolution(solution);
+
+    findLocalSearchSolution(solution,solutionValue,hash,maxIter);
+    bestValue = solutionValue;
+    bestSolution = solution;
+    reportProgress(bestValue);
+
+    return bestSolution;
+}
+
+set<int> maximumDiversityProblem::findMultiStartSolution(int first, int stride)
+{
+    const int maxIter = options.budget > 0 ? options.budget : 100000;
+
+    for (int i = first; i < options.starts; i += stride) {
+        // Cada arranque tiene su semilla para que el resultado no dependa del reparto entre hilos
+        reseed(seedFor(options.seed, options.firstStart + i));
+
+        // El primer arranque de la ejecucion completa parte de la solucion en caliente, si la hay
+        bool warm = options.firstStart + i == 0 && !options.start.empty();
+        set<int> random = warm ? warmSolution() : initialSolution();
+        double solutionValue = 0;
+        unsigned long long hash = hashSolution(random);
+
+        // Un arranque ya visto (o que es un optimo ya alcanzado) no repite la busqueda local
+        findCachedLocalSearchSolution(random,solutionValue,hash,maxIter);
+        offerElite(random, solutionValue, hash);
+        recordOptimum(random);
+
+        if(solutionValue > bestValue)
+        {
+            bestValue = solutionValue;
+            bestSolution = random;
+            publishBest();
+        }
+    }
+
+    return bestSolution;
+}
+
+set<int> maximumDiversityProblem::findIteratedLocalSearch()
+{
+    const int maxIter = options.budget > 0 ? options.budget : 10000;
+
+    set<int> solution = options.start.empty() ? initialSolution() : warmSolution();
+    double solutionValue = 0;
+    unsigned long long hash = hashSolution(solution);
+
+    findCachedLocalSearchSolution(solution,solutionValue,hash,maxIter);
+    offerElite(solution, solutionValue, hash);
+    recordOptimum(solution);
+    bestValue = solutionValue;
+    bestSolution = solution;
+    unsigned long long bestHash = hash;
+    publishBest();
+
+    for (int i = 1; i < options.starts; i++) {
+        mutate(solution, solutionValue, hash);
+        MDP_TRACE_EVENT(ring, TRACE_PERTURB, m / 10, 0, solutionValue, 0);
+
+        // Si la perturbacion lleva a una solucion ya explorada no repetimos la busqueda local
+        findCachedLocalSearchSolution(solution,solutionValue,hash,maxIter);
+        offerElite(solution, solutionValue, hash);
+        recordOptimum(solution);
+
+        if(solutionValue > bestValue)
+        {
+            bestValue = solutionValue;
+            bestSolution = solution;
+            bestHash = hash;
+            publishBest();
+        }
+
+        // Si otra busqueda ha llegado mas alto perturbamos su solucion
+        if(receiveBest()){
+            bestHash = hashSolution(bestSolution);
+        }
+
+        solution = bestSolution;
+        solutionValue = bestValue;
+        hash = bestHash;
+    }
+
+    return bestSolution;
+}
+
+set<int> maximumDiversityProblem::findIteratedSimAnnealing()
+{
+    const int maxEvaluations = options.budget > 0 ? options.budget : 10000;
+
+    set<int> solution = options.start.empty() ? initialSolution() : warmSolution();
+    double solutionValue = evaluation(solution);
+    unsigned long long hash = hashSolution(solution);
+
+    findSimAnnealingSolution(solution,solutionValue,maxEvaluations);
+    offerElite(solution, solutionValue, hashSolution(solution));
+    recordOptimum(solution);
+    bestValue = solutionValue;
+    bestSolution = solution;
+    publishBest();
+
+    for (int i = 1; i < options.starts; i++) {
+        mutate(solution, solutionValue, hash);
+        MDP_TRACE_EVENT(ring, TRACE_PERTURB, m / 10, 0, solutionValue, 0);
+
+        // El enfriamiento consume aleatorios, asi que no se puede reutilizar con la cache
+        findSimAnnealingSolution(solution,solutionValue,maxEvaluations);
+        offerElite(solution, solutionValue, hashSolution(solution));
+        recordOptimum(solution);
+
+        if(solutionValue > bestValue)
+        {
+            bestValue = solutionValue;
+            bestSolution = solution;
+            publishBest();
+        }
+
+        receiveBest();
+
+        solution = bestSolution;
+        solutionValue = bestValue;
+        hash = hashSolution(solution);
+    }
+
+    return bestSolution;
+}
+
+void maximumDiversityProblem::offerElite(const set<int> &solution, double value, unsigned long long hash)
+{
+    if(options.relinking){
+        elite.offer(solution, value, hash);
+    }
+}
+
+void maximumDiversityProblem::recordOptimum(const set<int> &solution)
+{
+    if(options.memory){
+        frequencies.record(solution);
+    }
+}
+
+set<int> maximumDiversityProblem::memorySolution()
+{
+    phaseScope scope(profiler.get(), CONSTRUCTION_PHASE, evaluations);
+
+    set<int> sol;
+
+    while((int) sol.size() < m){
+        sol.insert(frequencies.sample(random(), random()));
+    }
+
+    return sol;
+}
+
+bool maximumDiversityProblem::relinkPath(const set<int> &from, const set<int> &to)
+{
+    const int maxIter = options.budget > 0 ? options.budget : 10000;
+
+    // Solo cambian los elementos en los que difieren: salen los de from y entran los de to
+    vector<int> pulled, pushed;
+    set_difference(from.begin(), from.end(), to.begin(), to.end(), back_inserter(pulled));
+    set_difference(to.begin(), to.end(), from.begin(), from.end(), back_inserter(pushed));
+
+    const int d = pulled.size();
+    if(d < 2){
+        return false;
+    }
+
+    // Contribucion a la solucion actual de los que quedan por salir y por entrar: O(d*m) una vez y
+    // O(d) por paso, sin recorrer los n elementos
+    set<int> solution = from;
+    vector<double> pulledContribution(d), pushedContribution(d);
+    for(int a=0; a < d; a++){
+        pulledContribution[a] = getContribution(pulled[a], solution);
+        pushedContribution[a] = getContribution(pushed[a], solution);
+    }
+
+    double value = evaluation(from);
+    double sumValue = value;
+    double bestPathValue = -HUGE_VAL;
+    int bestStep = 0;
+    vector<pair<int,int>> steps;
+
+    // Cada paso hace el intercambio de un elemento de from por uno de to que mas sube la suma
+    // (delta en O(1) con las contribuciones). El ultimo paso llegaria a to, asi que no se da
+    for(int step=1; step < d; step++){
+        int bestOut = -1, bestIn = -1;
+        double bestDelta = -HUGE_VAL;
+
+        for(int a=0; a < (int) pulled.size(); a++){
+            for(int b=0; b < (int) pushed.size(); b++){
+                double delta = pushedContribution[b] - pulledContribution[a] - distance(pushed[b], pulled[a]);
+                if(delta > bestDelta){
+                    bestDelta = delta;
+                    bestOut = a;
+                    bestIn = b;
+                }
+            }
+        }
+        evaluations += pulled.size() * pushed.size();
+
+        int out = pulled[bestOut], in = pushed[bestIn];
+        solution.erase(out);
+        solution.insert(in);
+        sumValue += bestDelta;
+        steps.push_back({out, in});
+
+        pulled.erase(pulled.begin() + bestOut);
+        pulledContribution.erase(pulledContribution.begin() + bestOut);
+        pushed.erase(pushed.begin() + bestIn);
+        pushedContribution.erase(pushedContribution.begin() + bestIn);
+
+        for(size_t a=0; a < pulled.size(); a++){
+            pulledContribution[a] += distance(pulled[a], in) - distance(pulled[a], out);
+        }
+        for(size_t b=0; b < pushed.size(); b++){
+            pushedContribution[b] += distance(pushed[b], in) - distance(pushed[b], out);
+        }
+
+        value = options.objective == MAX_SUM ? sumValue : evaluation(solution);
+        if(value > bestPathValue){
+            bestPathValue = value;
+            bestStep = step;
+        }
+    }
+
+    // Busqueda local desde el mejor punto del camino
+    solution = from;
+    for(int step=0; step < bestStep; step++){
+        solution.erase(steps[step].first);
+        solution.insert(steps[step].second);
+    }
+
+    double solutionValue = bestPathValue;
+    unsigned long long hash = hashSolution(solution);
+    findCachedLocalSearchSolution(solution,solutionValue,hash,maxIter);
+
+    // Se compara con los valores recalculados, los que da el Solver: el acumulado por deltas podria
+    // superar al mejor solo por redondeo y el reenlazado empeoraria el resultado
+    solutionValue = evaluation(solution);
+    if(solutionValue > evaluation(bestSolution)){
+        bestValue = solutionValue;
+        bestSolution = solution;
+        publishBest();
+        return true;
+    }
+
+    return false;
+}
+
+set<int> maximumDiversityProblem::findVariableNeighborhoodSearch()
+{
+    const int maxIter = options.budget > 0 ? options.budget : 10000;
+    const int kmax = max(1, min(m / 5, n - m));
+
+    set<int> solution = options.start.empty() ? initialSolution() : warmSolution();
+    double solutionValue = 0;
+    unsigned long long hash = hashSolution(solution);
+
+    findCachedLocalSearchSolution(solution,solutionValue,hash,maxIter);
+    bestValue = solutionValue;
+    bestSolution = solution;
+    unsigned long long bestHash = hash;
+    publishBest();
+
+    // Con n == m no hay nadie fuera de la solucion con quien intercambiar
+    if(n == m){
+        return bestSolution;
+    }
+
+    // Contribucion de cada elemento a la mejor solucion: solo se recalcula cuando esta cambia
+    vector<double> contribution = contributionsTo(bestSolution);
+    int k = 1;
+
+    for (int i = 1; i < options.starts; i++) {
+        solution = bestSolution;
+        hash = bestHash;
+
+        solutionValue = shake(solution, contribution, bestValue, k, hash);
+        findCachedLocalSearchSolution(solution,solutionValue,hash,maxIter);
+
+        // Si mejora volvemos al vecindario mas pequenio; si no, probamos con uno mayor
+        if(solutionValue > bestValue)
+        {
+            bestValue = solutionValue;
+            bestSolution = solution;
+            bestHash = hash;
+            contribution = contributionsTo(bestSolution);
+            publishBest();
+            k = 1;
+        }else{
+            k = k % kmax + 1;
+        }
+
+        if(receiveBest()){
+            bestHash = hashSolution(bestSolution);
+            contribution = contributionsTo(bestSolution);
+        }
+    }
+
+    return bestSolution;
+}
+
+double maximumDiversityProblem::shake(set<int> &solution, const vector<double> &contribution, double value, int k, unsigned long long &hash)
+{
+    phaseScope scope(profiler.get(), PERTURBATION_PHASE, evaluations);
+
+    vector<int> members(solution.begin(), solution.end());
+    vector<int> pulled, pushed;
+
+    while((int) pulled.size() < k){
+        int item = members[random() % m];
+        if(find(pulled.begin(), pulled.end(), item) == pulled.end()){
+            pulled.push_back(item);
+        }
+    }
+    while((int) pushed.size() < k){
+        int item = random() % n;
+        if(!solution.count(item) && find(pushed.begin(), pushed.end(), item) == pushed.end()){
+            pushed.push_back(item);
+        }
+    }
+
+    // Valor tras el k-intercambio en O(k^2): los pares entre salientes se restaron dos veces y los
+    // entrantes no aportan su distancia a los salientes
+    for(int a=0; a < k; a++){
+        value -= contribution[pulled[a]];
+        for(int b=0; b < a; b++){
+            value += distance(pulled[a], pulled[b]);
+        }
+    }
+    for(int a=0; a < k; a++){
+        value += contribution[pushed[a]];
+        for(int b=0; b < k; b++){
+            value -= distance(pushed[a], pulled[b]);
+        }
+        for(int b=0; b < a; b++){
+            value += distance(pushed[a], pushed[b]);
+        }
+    }
+
+    // Aplicamos el movimiento sobre la solucion y el hash. Las contribuciones no se actualizan: la
+    // busqueda local que sigue parte de su propia submatriz
+    for(int a=0; a < k; a++){
+        solution.erase(pulled[a]);
+        solution.insert(pushed[a]);
+        hash ^= zobrist[pulled[a]] ^ zobrist[pushed[a]];
+    }
+
+    // Con Max-Min el valor no se puede factorizar con las contribuciones
+    if(options.objective == MAX_MIN){
+        value = evaluation(solution);
+    }
+
+    return value;
+}
+
+vector<double> maximumDiversityProblem::contributionsTo(const set<int> &solution)
+{
+    vector<double> contribution(n, 0.0);
+
+    for(int s : solution){
+        const double *row = data.getRow(s);
+        for(int j=0; j < n; j++){
+            contribution[j] += row[j];
+        }
+    }
+
+    return contribution;
+}
+
+set<int> maximumDiversityProblem::findRandomSimAnnealingSolution()
+{
+    const int maxEvaluations = options.budget > 0 ? options.budget : 100000;
+
+    set<int> solution = options.start.empty() ? randomSolution() : warmSolution();
+    double value = evaluation(solution);
+
+    findSimAnnealingSolution(solution,value,maxEvaluations);
+    bestValue = value;
+    bestSolution = solution;
+    reportProgress(bestValue);
+
+    return bestSolution;
+}
+
+set<int> maximumDiversityProblem::findGreedySolution()
+{
+    // contribution: suma de distancias de cada elemento a los elegidos
+    // candidate: igual pero con -infinito en los elegidos, para que argmax no tenga que comprobarlos
+    vector<double> contribution(n, 0.0);
+    vector<double> candidate(n, 0.0);
+
+    // El primero es el de mayor suma de distancias
+    for(int i=0; i < n; i++){
+        candidate[i] = data.getRowSum(i);
+    }
+    int item = argmax(candidate.data(), n);
+    candidate.assign(n, 0.0);
+
+    set<int> sol;
+
+    while(true){
+        sol.insert(item);
+        candidate[item] = -HUGE_VAL;
+
+        const double *row = data.getRow(item);
+        if(options.objective == MAX_MIN){
+            // Max-Min: el candidato vale su distancia al elegido mas cercano
+            if(sol.size() == 1){
+                candidate.assign(n, HUGE_VAL);
+                candidate[item] = -HUGE_VAL;
+            }
+            for(int j=0; j < n; j++){
+                candidate[j] = min(candidate[j], row[j]);
+            }
+        }else{
+            for(int j=0; j < n; j++){
+                contribution[j] += row[j];
+                candidate[j] += row[j];
+            }
+        }
+
+        if((int) sol.size() == m){
+            break;
+        }
+
+        item = argmax(candidate.data(), n);
+        evaluations += n;
+    }
+
+    // La pasada de mejora usa las contribuciones, que solo sirven para MaxSum
+    if(options.polish && options.objective == MAX_SUM){
+        // Una sola pasada: cada elegido se cambia por el no elegido con mayor mejora, si la hay
+        vector<int> selected(sol.begin(), sol.end());
+
+        for(int i : selected){
+            const double *row = data.getRow(i);
+            double bestDelta = 0;
+            int bestJ = -1;
+
+            for(int j=0; j < n; j++){
+                if(sol.count(j) == 0){
+                    double delta = contribution[j] - row[j] - contribution[i];
+                    if(delta > bestDelta){
+                        bestDelta = delta;
+                        bestJ = j;
+                    }
+                }
+            }
+            evaluations += n - m;
+
+            if(bestJ >= 0){
+                sol.erase(i);
+                sol.insert(bestJ);
+
+                const double *in = data.getRow(bestJ);
+                for(int j=0; j < n; j++){
+                    contribution[j] += in[j] - row[j];
+                }
+            }
+        }
+    }
+
+    bestSolution = sol;
+    bestValue = evaluation(bestSolution);
+    reportProgress(bestValue);
+
+    return bestSolution;
+}
+
+set<int> maximumDiversityProblem::findExhaustiveSolution(int first, int stride)
+{
+    vector<int> chosen;
+    chosen.reserve(m);
+
+    bestValue = -1.0;
+
+    // Cada hilo se queda con los subarboles de los primeros elementos first, first+stride...
+    for(int j = first; j <= n - m; j += stride){
+        chosen.push_back(j);
+        enumerate(chosen, j + 1, options.objective == MAX_MIN ? HUGE_VAL : 0.0);
+        chosen.pop_back();
+    }
+
+    return bestSolution;
+}
+
+void maximumDiversityProblem::enumerate(vector<int> &chosen, int from, double value)
+{
+    int k = chosen.size();
+
+    if(k == m){
+        evaluations++;
+        if(value > bestValue){
+            bestValue = value;
+            bestSolution = set<int>(chosen.begin(), chosen.end());
+            reportProgress(bestValue);
+        }
+        return;
+    }
+
+    // Quedan m-k por elegir: j no puede pasar de n-(m-k)
+    for(int j = from; j <= n - (m - k); j++){
+        // Valor con j a partir del de los k ya elegidos: O(k)
+        const double *row = data.getRow(j);
+        double next = value;
+
+        if(options.objective == MAX_MIN){
+            next = k == 0 ? HUGE_VAL : value;
+            for(int c : chosen){
+                next = min(next, row[c]);
+            }
+            // El minimo solo puede bajar: esta rama no supera la mejor
+            if(k > 0 && next <= bestValue){
+                continue;
+            }
+        }else{
+            for(int c : chosen){
+                next += row[c];
+            }
+        }
+
+        chosen.push_back(j);
+        enumerate(chosen, j + 1, next);
+        chosen.pop_back();
+    }
+}
+
+void maximumDiversityProblem::reportProgress(double value)
+{
+    if(options.progress){
+        options.progress->improved(value);
+    }
+}
+
+void maximumDiversityProblem::publishBest()
+{
+    reportProgress(bestValue);
+    MDP_TRACE_EVENT(ring, TRACE_BEST, 0, 0, bestValue, 0);
+
+    if(options.cooperation){
+        vector<int> solution;
+        for(int i : bestSolution){
+            solution.push_back(data.getLabel(i));
+        }
+        options.cooperation->publish(bestValue, solution);
+    }
+}
+
+bool maximumDiversityProblem::receiveBest()
+{
+    double value = bestValue;
+    vector<int> solution;
+
+    if(!options.cooperation || !options.cooperation->receive(value, solution) || value <= bestValue){
+        return false;
+    }
+
+    set<int> received;
+    for(int label : solution){
+        if(data.getPosition(label) < 0){
+            return false;
+        }
+        received.insert(data.getPosition(label));
+    }
+    if((int) received.size() != m){
+        return false;
+    }
+
+    bestSolution = received;
+    bestValue = evaluation(bestSolution);
+
+    return true;
+}
+
+set<int> maximumDiversityProblem::mutate(set<int> &solution, double &value, unsigned long long &hash)
+{
+    phaseScope scope(profiler.get(), PERTURBATION_PHASE, evaluations);
+
+    const int NUM_MUT = m/10;
+
+    for(int i=0; i<NUM_MUT; i++){
+        int random_it = random() % m;
+        auto it = next(solution.begin(), random_it);
+
+        // Con memoria sale el mas repetido de dos elegidos al azar: el resto de la solucion se ha explorado menos
+        if(options.memory){
+            auto other = next(solution.begin(), random() % m);
+            if(frequencies.count(*other) > frequencies.count(*it)){
+                it = other;
+            }
+        }
+
+        int item2pull = (int) *it;
+        int item2push = 0;
+
+        solution.erase(item2pull);
+        value -= getContribution(item2pull,solution);
+
+        // Y entra uno prometedor y poco elegido
+        do{
+            item2push = options.memory ? frequencies.sample(random(), random()) : random() % n;
+            solution.insert(item2push);
+        }while((int) solution.size() < m);
+
+        value += getContribution(item2push,solution);
+        hash ^= zobrist[item2pull] ^ zobrist[item2push];
+        threshold[item2push] = HUGE_VAL;
+    }
+
+    // Con Max-Min el valor no se puede factorizar con las contribuciones
+    if(options.objective == MAX_MIN){
+        value = evaluation(solution);
+    }
+
+    return solution;
+}
+
+set<int> maximumDiversityProblem::randomSolution()
+{
+    phaseScope scope(profiler.get(), CONSTRUCTION_PHASE, evaluations);
+
+    set<int> sol;
+
+    while((int) sol.size() < m){
+        sol.insert(random()%n);
+    }
+
+    return sol;
+}
+
+set<int> maximumDiversityProblem::graspSolution()
+{
+    phaseScope scope(profiler.get(), CONSTRUCTION_PHASE, evaluations);
+
+    set<int> sol;
+
+    // Contribucion de cada elemento a los ya seleccionados
+    vector<double> contribution(n, 0.0);
+    vector<bool> selected(n, false);
+
+    // El primero al azar: todos tienen contribucion 0
+    int item = random() % n;
+
+    while(true){
+        sol.insert(item);
+        selected[item] = true;
+
+        if((int) sol.size() == m){
+            break;
+        }
+
+        const double *row = data.getRow(item);
+        double cmax = -1.0, cmin = 0;
+        bool first = true;
+
+        for(int j=0; j < n; j++){
+            contribution[j] += row[j];
+
+            if(!selected[j]){
+                if(first || contribution[j] > cmax) cmax = contribution[j];
+                if(first || contribution[j] < cmin) cmin = contribution[j];
+                first = false;
+            }
+        }
+
+        // Lista restringida de candidatos y eleccion al azar entre ellos
+        const double threshold = cmax - options.alpha * (cmax - cmin);
+        vector<int> rcl;
+        for(int j=0; j < n; j++){
+            if(!selected[j] && contribution[j] >= threshold){
+                rcl.push_back(j);
+            }
+        }
+
+        item = rcl[random() % rcl.size()];
+    }
+
+    return sol;
+}
+
+set<int> maximumDiversityProblem::warmSolution()
+{
+    phaseScope scope(profiler.get(), CONSTRUCTION_PHASE, evaluations);
+
+    set<int> sol;
+    bool complete = true;
+
+    for(int label : options.start){
+        int i = data.getPosition(label);
+        if(i >= 0 && (int) sol.size() < m){
+            sol.insert(i);
+        }else{
+            complete = false;
+        }
+    }
+
+    // Completamos con el que mas aporta a los que quedan, como el greedy
+    if((int) sol.size() < m){
+        complete = false;
+
+        vector<double> candidate(n, 0.0);
+        for(int s : sol){
+            const double *row = data.getRow(s);
+            for(int j=0; j < n; j++){
+                candidate[j] += row[j];
+            }
+        }
+        for(int s : sol){
+            candidate[s] = -HUGE_VAL;
+        }
+
+        while((int) sol.size() < m){
+            int item = argmax(candidate.data(), n);
+            sol.insert(item);
+            candidate[item] = -HUGE_VAL;
+
+            const double *row = data.getRow(item);
+            for(int j=0; j < n; j++){
+                candidate[j] += row[j];
+            }
+        }
+    }
+
+    // Solo si la solucion anterior sigue entera vale restringir la primera busqueda a lo cambiado
+    focused = complete && !options.changed.empty() && options.objective == MAX_SUM;
+    focus.clear();
+    for(int label : options.changed){
+        int i = data.getPosition(label);
+        if(i >= 0){
+            focus.push_back(i);
+        }
+    }
+
+    return sol;
+}
+
+set<int> maximumDiversityProblem::initialSolution()
+{
+    if(options.construction == GRASP_CONSTRUCTION){
+        return graspSolution();
+    }
+
+    return options.memory ? memorySolution() : randomSolution();
+}
+
+set<int> maximumDiversityProblem::findLocalSearchSolution(set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter)
+{
+  phaseScope scope(profiler.get(), DESCENT_PHASE, evaluations);
+
+  // Tras un arranque en caliente basta con mirar los intercambios que tocan a los elementos cambiados
+  if(focused){
+      focused = false;
+      if(!findFocusedSwap(solution, solutionValue, hash, focus)){
+          return solution;
+      }
+  }
+
+  if(options.objective == MAX_MIN){
+      return findMaxMinLocalSearchSolution(solution, solutionValue, hash, maxIter);
+  }
+
+  // Los hilos de las pasadas se crean en la primera busqueda que tiene trabajo para repartirles
+  if(scanThreads > 1 && !scanner && (long long) (n - m) * m >= SCAN_MIN_WORK){
+      scanner.reset(new scanPool(scanThreads));
+  }
+
+  // La valoracion de la solucion de la que partimos, con su submatriz
+  selection.init(solution);
+  solutionValue = selection.value();
+  MDP_TRACE_EVENT(ring, TRACE_DESCENT_START, 0, 0, solutionValue, 0);
+
+  bool isEnd = false;
+  int iterations = 0;
+
+  // Bits de no mirar: un elegido que no ha encontrado con quien cambiarse no se vuelve a probar mientras
+  // su contribucion no baje de la mayor que podia aportar el mejor candidato a entrar (su umbral). Los que
+  // entran empiezan activos. Como los candidatos tambien cambian el umbral es solo una estimacion: si una
+  // pasada no mejora, se prueban los que se salto (checked marca los ya probados con la solucion actual)
+  for(int s : solution){
+      threshold[s] = HUGE_VAL;
+  }
+  bool verifying = false;
+  int pass = ++passes;
+
+  // Bucle que finaliza en caso de que llegamos al maximo de iteraciones o se recorre todos los vecinos sin encontrar solucion mejor
+  while(!isEnd){
+      // sorted es un vector con los elementos de selecionados ordenados por su contribucion
+      vector<int> sorted = sortSolution(solution);
+      bool hasImproved = false;
+      bool passSkipped = false;
+      int i = 0;
+
+      // Elemento candidato a extraerse de selecionados; Elemento candidato a introducirse en selecionados
+      int item2pull, item2push;
+      // Contribuciones del elemento a extraerse e introducirse respectivamente
+      double cont2pull, cont2push, delta;
+
+      // Mientras no mejoremos la solucion y no hayamos recorrido todos los elementos de seleccionados
+      while(!hasImproved && !isEnd){
+          // Con hilos, cada pasada entera (normal o de comprobacion) se reparte de una vez
+          if(scanner && i == 0){
+              int evaluated = 0;
+              int k = parallelPass(solution, sorted, verifying, pass, maxIter - iterations, item2push, delta, evaluated, passSkipped);
+
+              if(k >= 0){
+                  iterations += evaluated;
+                  isEnd = iterations > maxIter;
+
+                  if(k < (int) sorted.size()){
+                      item2pull = sorted[k];
+                      hasImproved = true;
+                  }else if(verifying || !passSkipped){
+                      isEnd = true;
+                  }else{
+                      verifying = true;
+                  }
+                  continue;
+              }
+          }
+
+          // Obtenemos el siguiente elemento candidato a extrerse, que sera el que menos contribuya de los restantes
+          item2pull = sorted[i];
+          //La contribucion ya esta en la submatriz
+          cont2pull = selection.contribution(item2pull);
+          int j = 0;
+
+          // Mayor contribucion (o cota de ella) de los candidatos a entrar
+          double bestPush = -HUGE_VAL;
+
+          if(verifying ? checked[item2pull] == pass : cont2pull >= threshold[item2pull]){
+              if(!verifying){
+                  skipped++;
+                  passSkipped = true;
+              }
+              j = n;
+          }
+
+          // Mientras no mejoremos la solucion y no hayamos recorrido todos los elementos que se pueden introducir
+          while(!hasImproved && !isEnd && j < n){
+              if(solution.find(j) == solution.end()){ // Comprueba que el elemento no esta en selecionados => EVITA SOLUCION INCORRECTA
+                  item2push = j;
+                  // Si ni sus m-1 mayores distancias superan lo que aporta el que sale no puede mejorar
+                  // Lo que aportaria a los elegidos sin el que sale
+                  double bound = data.getContributionBound(j);
+                  cont2push = bound > cont2pull ? selection.contributionOf(item2push) - distance(item2push, item2pull) : cont2pull;
+                  bestPush = max(bestPush, min(bound, cont2push));
+
+                  // Diferencia entre las contribuciones
+                  delta = cont2push - cont2pull;
+
+                  iterations++;
+
+                  // Si la diferencia es positiva hemos encontrado uno que mejora y salimos para hacer el cambio => BUSQUEDA LOCAL DEL PRIMER MEJOR
+                  hasImproved = improves(delta, cont2pull);
+                  isEnd = iterations > maxIter;
+              }
+
+              j++;
+          }
+
+          // Ha recorrido todos los candidatos sin mejorar: no se mira hasta que baje de bestPush
+          if(!hasImproved && j == n && bestPush > -HUGE_VAL){
+              threshold[item2pull] = bestPush;
+              checked[item2pull] = pass;
+          }
+
+          i++;
+          isEnd = isEnd || iterations > maxIter;
+
+          // Fin de la pasada: si se salto algun elegido comprobamos todos antes de terminar
+          if(!hasImproved && !isEnd && i == (int) sorted.size()){
+              if(verifying || !passSkipped){
+                  isEnd = true;
+              }else{
+                  verifying = true;
+                  i = 0;
+              }
+          }
+      }
+
+      // Si hay mejora la solucion hace el intercambio en seleccionados y actualiza el valor de la solucion actual sin recalcular todo
+      if(hasImproved){
+          solution.erase(item2pull);
+          solution.insert(item2push);
+          selection.swap(item2pull, item2push);
+          solutionValue += delta;
+          hash ^= zobrist[item2pull] ^ zobrist[item2push];
+          threshold[item2push] = HUGE_VAL;
+          verifying = false;
+          pass = ++passes;
+          MDP_TRACE_EVENT(ring, TRACE_MOVE, item2pull, item2push, solutionValue, delta);
+      }
+  }
+
+  evaluations += iterations;
+  MDP_TRACE_EVENT(ring, TRACE_DESCENT_END, iterations, 0, solutionValue, 0);
+
+  return solution;
+}
+
+int maximumDiversityProblem::parallelPass(const set<int> &solution, const vector<int> &sorted, bool verifying, int pass, int budget,
+                                          int &item2push, double &delta, int &evaluated, bool &passSkipped)
+{
+    const int size = sorted.size();
+
+    // Los que no se saltan por su bit de no mirar, en el orden de la pasada
+    scanPulls.clear();
+    for(int k=0; k < size; k++){
+        int item = sorted[k];
+        if(!(verifying ? checked[item] == pass : selection.contribution(item) >= threshold[item])){
+            scanPulls.push_back(k);
+        }
+    }
+    const int pulls = scanPulls.size();
+
+    // Tareas: cada elegido por bloques de SCAN_BLOCK candidatos, en el orden de la pasada en serie. Cada
+    // tarea guarda la mayor contribucion (o cota) de los candidatos que ha recorrido
+    const int blocks = (n + SCAN_BLOCK - 1) / SCAN_BLOCK;
+    const int tasks = pulls * blocks;
+    scanBest.assign(tasks, -HUGE_VAL);
+
+    // Los hilos cogen las tareas en orden y no siguen por detras del primer par (elegido, candidato) que
+    // mejora ya encontrado (found = posicion en scanPulls * n + candidato) ni fuera del presupuesto:
+    // todo lo anterior al primer par que mejora se recorre, asi que el elegido es el mismo que en serie
+    const long long none = (long long) pulls * n;
+    atomic<long long> found(none);
+    atomic<int> next(0);
+
+    if(tasks > 0){
+        scanner->run([&](int){
+            for(int task = next++; task < tasks; task = next++){
+                int q = task / blocks;
+                int first = task % blocks * SCAN_BLOCK;
+                if((long long) q * n + first > found.load(memory_order_relaxed) || (long long) q * (n - m) > budget){
+                    break;
+                }
+
+                int item2pull = sorted[scanPulls[q]];
+                double cont2pull = selection.contribution(item2pull);
+                double bestPush = -HUGE_VAL;
+
+                for(int j = first; j < min(n, first + SCAN_BLOCK); j++){
+                    if((long long) q * n + j > found.load(memory_order_relaxed)){
+                        break;
+                    }
+                    if(solution.find(j) != solution.end()){
+                        continue;
+                    }
+
+                    double bound = data.getContributionBound(j);
+                    double cont2push = bound > cont2pull ? selection.contributionOf(j) - distance(j, item2pull) : cont2pull;
+                    bestPush = max(bestPush, min(bound, cont2push));
+
+                    if(improves(cont2push - cont2pull, cont2pull)){
+                        long long key = (long long) q * n + j;
+                        long long current = found.load();
+                        while(key < current && !found.compare_exchange_weak(current, key)){}
+                        break;
+                    }
+                }
+                scanBest[task] = bestPush;
+            }
+        });
+    }
+
+    // Vecinos que habria evaluado la pasada en serie hasta el par elegido (o entera). En serie se
+    // paraba al pasar de budget: si no llega al par elegido se repite la pasada en serie
+    int winner = found / n;
+    long long count = (long long) winner * (n - m);
+    if(winner < pulls){
+        int j = found % n;
+        count += j + 1 - std::distance(solution.begin(), solution.lower_bound(j));
+        if(count > (long long) budget + 1){
+            return -1;
+        }
+    }else if(count > budget){
+        return -1;
+    }
+    evaluated = count;
+
+    // Bits de no mirar como en serie: los saltados hasta el que sale y los umbrales de los que no mejoraron
+    int end = winner < pulls ? scanPulls[winner] : size;
+    if(!verifying){
+        for(int k=0, q=0; k < end; k++){
+            if(q < pulls && scanPulls[q] == k){
+                q++;
+            }else{
+                skipped++;
+                passSkipped = true;
+            }
+        }
+    }
+    for(int q=0; q < winner; q++){
+        double bestPush = -HUGE_VAL;
+        for(int b=0; b < blocks; b++){
+            bestPush = max(bestPush, scanBest[q * blocks + b]);
+        }
+        if(bestPush > -HUGE_VAL){
+            threshold[sorted[scanPulls[q]]] = bestPush;
+            checked[sorted[scanPulls[q]]] = pass;
+        }
+    }
+
+    if(winner == pulls){
+        return size;
+    }
+
+    int item2pull = sorted[scanPulls[winner]];
+    double cont2pull = selection.contribution(item2pull);
+    item2push = found % n;
+    delta = selection.contributionOf(item2push) - distance(item2push, item2pull) - cont2pull;
+
+    return scanPulls[winner];
+}
+
+bool maximumDiversityProblem::findFocusedSwap(set<int> &solution, double &solutionValue, unsigned long long &hash, const vector<int> &changed)
+{
+    solutionValue = evaluation(solution);
+
+    vector<bool> isChanged(n, false);
+    bool changedSelected = false;
+    for(int i : changed){
+        isChanged[i] = true;
+        changedSelected = changedSelected || solution.count(i);
+    }
+
+    // Contribucion a la solucion de los posibles entrantes: todos si sale algun elemento cambiado,
+    // si no solo los cambiados (el resto de pares no ha variado y ya no mejoraba)
+    vector<double> contribution(n, 0.0);
+    for(int j=0; j < n; j++){
+        if((changedSelected || isChanged[j]) && !solution.count(j)){
+            contribution[j] = getContribution(j, solution);
+        }
+    }
+
+    int iterations = 0;
+    bool hasImproved = false;
+    int item2pull = -1, item2push = -1;
+    double delta = 0;
+
+    for(auto it = solution.begin(); it != solution.end() && !hasImproved; it++){
+        item2pull = *it;
+        double cont2pull = getContribution(item2pull, solution);
+
+        auto tryPush = [&](int j){
+            if(solution.count(j)){
+                return false;
+            }
+            iterations++;
+            delta = contribution[j] - distance(j, item2pull) - cont2pull;
+            item2push = j;
+            return improves(delta, cont2pull);
+        };
+
+        if(isChanged[item2pull]){
+            for(int j=0; j < n && !hasImproved; j++){
+                hasImproved = tryPush(j);
+            }
+        }else{
+            for(int j : changed){
+                if(hasImproved){
+                    break;
+                }
+                hasImproved = tryPush(j);
+            }
+        }
+    }
+
+    evaluations += iterations;
+
+    if(hasImproved){
+        solution.erase(item2pull);
+        solution.insert(item2push);
+        solutionValue += delta;
+        hash ^= zobrist[item2pull] ^ zobrist[item2push];
+    }
+
+    return hasImproved;
+}
+
+set<int> maximumDiversityProblem::findMaxMinLocalSearchSolution(set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter)
+{
+    tracker.init(solution);
+    solutionValue = tracker.value();
+
+    int iterations = 0;
+    bool isEnd = false;
+
+    while(!isEnd){
+        bool hasImproved = false;
+
+        // Solo sacando un extremo de un par a la menor distancia puede subir el minimo. Se acepta todo
+        // cambio cuyo candidato quede a mas del minimo de los demas: el valor sube o, si hay empates
+        // (distancias repetidas), baja el numero de pares a la menor distancia, asi que no cicla
+        for(int item2pull : tracker.critical()){
+            for(int item2push = 0; item2push < n && !hasImproved && !isEnd; item2push++){
+                if(solution.count(item2push)){
+                    continue;
+                }
+
+                iterations++;
+                isEnd = iterations > maxIter;
+
+                // Distancia del candidato a los que se quedan, parando en cuanto no mejora
+                const double *row = data.getRow(item2push);
+                double added = HUGE_VAL;
+                for(int s : solution){
+                    if(s != item2pull && row[s] < added){
+                        added = row[s];
+                        if(added <= solutionValue){
+                            break;
+                        }
+                    }
+                }
+
+                if(added > solutionValue){
+                    applySwap(solution, item2pull, item2push);
+                    hash ^= zobrist[item2pull] ^ zobrist[item2push];
+                    solutionValue = tracker.value();
+                    hasImproved = true;
+                }
+            }
+
+            if(hasImproved || isEnd){
+                break;
+            }
+        }
+
+        isEnd = isEnd || !hasImproved;
+    }
+
+    evaluations += iterations;
+
+    return solution;
+}
+
+set<int> maximumDiversityProblem::findCachedLocalSearchSolution(set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter)
+{
+    unsigned long long start = hash;
+    cacheLookups++;
+
+    // Cada entrada es la solucion a la que baja desde esa solucion una busqueda local con los bits de no
+    // mirar recien activados y el mismo maxIter. Esa busqueda es determinista, asi que un acierto da lo
+    // mismo que repetirla aunque maxIter la cortara antes de llegar a un optimo local
+    auto it = cache.find(start);
+    if(it != cache.end() && it->second.budget == maxIter){
+        cacheHits++;
+        solution = it->second.optimum;
+        solutionValue = it->second.value;
+        hash = hashSolution(solution);
+        return solution;
+    }
+
+    // Tras un arranque en caliente la busqueda solo mira los cambiados: no es funcion de la partida
+    bool fresh = !focused;
+    long long before = evaluations;
+
+    findLocalSearchSolution(solution,solutionValue,hash,maxIter);
+
+    if(fresh){
+        cacheStore(start, solution, solutionValue, maxIter);
+    }
+
+    // Si la busqueda acabo sin cortarse es un optimo local, y una busqueda desde el no se mueve
+    if(evaluations - before <= maxIter && hash != start){
+        cacheStore(hash, solution, solutionValue, maxIter);
+    }
+
+    return solution;
+}
+
+void maximumDiversityProblem::cacheStore(unsigned long long key, const set<int> &optimum, double value, int budget)
+{
+    if(cache.find(key) != cache.end()){
+        return;
+    }
+
+    if(cacheOrder.size() >= CACHE_SIZE){
+        cache.erase(cacheOrder.front());
+        cacheOrder.pop_front();
+    }
+
+    cache[key] = {optimum, value, budget};
+    cacheOrder.push_back(key);
+}
+
+set<int> maximumDiversityProblem::findSimAnnealingSolution(set<int> &solution, double &value, int maxEvaluations)
+{
+  int num_success, num_neighbor;
+  const int max_neighbor = 10  * m;
+  const int max_success  = (int) (0.1 * max_neighbor);
+  const int NE = max(1, maxEvaluations/max_neighbor); // NE: Numero de Enfriamientos => M
+
+  // Movimiento al vecino: sale item2pull y entra item2push
+  int item2pull, item2push;
+
+  if(options.objective == MAX_MIN){
+      tracker.init(solution);
+  }else{
+      selection.init(solution);
+  }
+
+  set<int> best = solution;
+  double cost = value;
+  double bs_cost = cost;
+  double nc = 0;
+
+  // Con Max-Min el coste de partida vale 0 en cuanto dos elegidos estan a distancia 0: la escala de la
+  // temperatura sale entonces de lo que cambia el coste en una muestra de vecinos y, si ninguno lo
+  // cambia (quedan otros pares a distancia 0), de la distancia media de los elegidos
+  double scale = cost;
+  if(options.objective == MAX_MIN){
+      double sum = 0;
+      int changes = 0;
+      for(int k=0; k < m; k++){
+          randomNeighbor(solution, item2pull, item2push);
+          if(item2pull != item2push){
+              double d = fabs(swapValue(cost, item2pull, item2push) - cost);
+              sum += d;
+              changes += d > 0;
+          }
+      }
+      evaluations += m;
+      if(changes > 0){
+          scale = max(scale, sum / changes);
+      }else if(scale <= 0){
+          for(int i : solution){
+              scale += data.getRowSum(i) / (n - 1);
+          }
+          scale /= m;
+      }
+  }
+
+  double tmp = (MU * scale)/(-log(PHI));
+
+  // Ningun vecino cambia el coste (todas las distancias iguales): no hay nada que enfriar
+  if(tmp <= 0){
+      value = evaluation(solution);
+      return solution;
+  }
+
+  // Con Max-Min el coste puede ser menor que la temperatura final fija: se limita a una fraccion de la inicial
+  const double final_tmp = min(10e-3, tmp * 1e-3);
+  double beta = (tmp - final_tmp)/(NE * final_tmp * tmp);
+  double delta = 0;
+
+  // Esquema adaptativo: la longitud de cada nivel depende de la tasa de aceptacion del anterior
+  const int max_evaluations = NE * max_neighbor;
+  int plateau_neighbor = max_neighbor;
+  int plateau_success  = max_success;
+  int stall  = 0;         // Niveles seguidos sin mejorar la mejor solucion
+  int frozen = 0;         // Niveles seguidos sin aceptar ningun vecino
+  double best_tmp = tmp;  // Temperatura de la ultima mejora: a ella se vuelve al recalentar
+  int num_evaluations = 0;
+
+  // Con Max-Min el valor va por mesetas de empates y la mejor casi nunca sube en un nivel: parar por
+  // niveles sin mejora corta el enfriamiento a los pocos cientos de vecinos
+  const int maxStall = options.objective == MAX_MIN ? 0 : options.maxStall;
+
+  while(tmp > final_tmp && num_evaluations < max_evaluations && (maxStall == 0 || stall < maxStall)){
+
+     num_neighbor = 0;
+     num_success  = 0;
+     bool improved = false;
+
+     // El enfriamiento suma sus evaluaciones al final: los vecinos del nivel se pasan a mano
+     if(profiler){
+         profiler->begin(PLATEAU_PHASE);
+     }
+
+     while(num_success < plateau_success && num_neighbor < plateau_neighbor && num_evaluations + num_neighbor < max_evaluations){
+
+         randomNeighbor(solution, item2pull, item2push);
+         // Coste de vecino: se factoriza a partir del actual en O(m)
+         nc = item2pull == item2push ? cost : swapValue(cost, item2pull, item2push);
+
+         delta = cost - nc;
+
+         num_neighbor++;
+
+         if(delta <= 0) // Si delta == 0 => exp(-delta/tmp) = exp(0) = 1 => random < exp ? == true
+         {
+             applySwap(solution, item2pull, item2push);
+             cost = nc;
+             num_success++;
+             MDP_TRACE_EVENT(ring, TRACE_ACCEPT, item2pull, item2push, cost, delta);
+
+             if(bs_cost < cost)
+             {
+                 best = solution;
+                 bs_cost = cost;
+                 reportProgress(bs_cost);
+                 MDP_TRACE_EVENT(ring, TRACE_BEST, 0, 0, bs_cost, 0);
+                 improved = true;
+             }
+         }
+         else
+         {
+             //Generamos un random entre 0,1
+             double r = random() % (int) 1e8;
+             r /= 1e8;
+
+             if(r <= exp(-delta/tmp))
+             {
+                 applySwap(solution, item2pull, item2push);
+                 cost = nc;
+                 num_success++;
+                 MDP_TRACE_EVENT(ring, TRACE_ACCEPT, item2pull, item2push, cost, delta);
+             }else{
+                 MDP_TRACE_EVENT(ring, TRACE_REJECT, item2pull, item2push, nc, delta);
+             }
+         }
+     }
+
+     num_evaluations += num_neighbor;
+
+     if(profiler){
+         profiler->end(PLATEAU_PHASE, num_neighbor);
+     }
+
+     // El coste se ha ido factorizando: al final de cada nivel se corrige con la submatriz
+     if(options.objective == MAX_SUM){
+         cost = selection.value();
+     }
+     MDP_TRACE_EVENT(ring, TRACE_TEMPERATURE, num_neighbor, num_success, cost, tmp);
+
+     // Si casi todo se acepta el nivel llega enseguida al equilibrio y se acorta;
+     // si casi nada se acepta hacen falta mas vecinos para salir del optimo y se alarga
+     double acceptance = (double) num_success / num_neighbor;
+     if(acceptance > ACC_HIGH){
+         plateau_neighbor = max(plateau_neighbor / 2, max_neighbor / 4);
+     }else if(acceptance < ACC_LOW){
+         plateau_neighbor = min(plateau_neighbor * 2, max_neighbor * 4);
+     }
+     plateau_success = max(1, (int) (0.1 * plateau_neighbor));
+
+     if(improved){
+         stall = 0;
+         best_tmp = tmp;
+     }else{
+         stall++;
+     }
+     frozen = num_success == 0 ? frozen + 1 : 0;
+
+     // Busqueda congelada: recalentamos a la temperatura de la ultima mejora
+     if(frozen >= FROZEN_PLATEAUS && best_tmp > tmp){
+         tmp = best_tmp;
+         frozen = 0;
+     }else{
+         tmp = tmp / (1 + beta * tmp);
+     }
+  }
+
+  evaluations += num_evaluations;
+
+  // El coste se ha ido factorizando: lo recalculamos para no arrastrar error de redondeo
+  solution = best;
+  value = evaluation(best);
+
+  return best;
+}
+
+void maximumDiversityProblem::randomNeighbor(const set<int> &sol, int &item2pull, int &item2push)
+{
+    int i = random() % m;
+
+    item2pull = *next(sol.begin(),i);
+
+    // Puede volver a entrar el que sale: entonces el vecino es la misma solucion
+    do{
+        item2push = random() % n;
+    }while(item2push != item2pull && sol.count(item2push));
+}
+
+double maximumDiversityProblem::swapValue(double value, int out, int in)
+{
+    if(options.objective == MAX_MIN){
+        return tracker.swapValue(out, in);
+    }
+
+    return selection.swapValue(value, out, in);
+}
+
+void maximumDiversityProblem::applySwap(set<int> &solution, int out, int in)
+{
+    solution.erase(out);
+    solution.insert(in);
+
+    if(options.objective == MAX_MIN){
+        tracker.swap(out, in);
+    }else{
+        selection.swap(out, in);
+    }
+}
+
+double maximumDiversityProblem::evaluation()
+{
+    return evaluation(bestSolution);
+}
+
+vector<int> maximumDiversityProblem::sortSolution(const set<int> &solution)
+{
+    vector<int> sort_solution(solution.begin(),solution.end());
+    vector<double> set_distances;
+
+    // Calcula las distancias (contribucion en la diversidad) de cada elemento de seleccionados al resto en un vector
+    for(int i : solution){
+        set_distances.push_back(selection.contribution(i));
+    }
+
+    int lower_idx;
+    double lower_dis;
+
+    // Ordenamos selecionados por orden de menor contribucion usando el vector anterior
+    for(int i=0; i<m; i++){
+        int idx = i;
+        for(int j=i; j<m; j++){
+            if(set_distances[j] < set_distances[idx]){
+                idx = j;
+            }
+        }
+
+        // Intercambio
+        lower_dis = set_distances[idx];
+        set_distances[idx] = set_distances[i];
+        set_distances[i] = lower_dis;
+
+        lower_idx = sort_solution[idx];
+        sort_solution[idx] = sort_solution[i];
+        sort_solution[i] = lower_idx;
+    }
+
+    return sort_solution;
+}
+
+double maximumDiversityProblem::getContribution(int i, const set<int> &set)
+{
+    const double *row = data.getRow(i);
+    double accum = 0;
+
+    for(int j : set){
+        accum += row[j];
+    }
+
+    return accum;
+}
+
+double maximumDiversityProblem::evaluation(const set<int> &sol)
+{
+    if(options.objective == MAX_MIN){
+        return (int) sol.size() == m ? minDistance(data, sol) : -1;
+    }
+
+    //Si no es una solucion
+    if((int) sol.size() != m){
+        return -1;
+    }
+
+    scratch.assign(sol.begin(), sol.end());
+    return kernels.evaluate(data, scratch.data(), m);
+}
+
+unsigned long long maximumDiversityProblem::hashSolution(const set<int> &sol)
+{
+    unsigned long long hash = 0;
+
+    for(int i : sol){
+        hash ^= zobrist[i];
+    }
+
+    return hash;
+}
+
+}
@@ -0,0 +1,299 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Estado de una ejecucion de libmdp (uso interno de la biblioteca). Contiene los algoritmos de
+    los ejecutables de la practica sobre un Instance compartido: cada hilo usa su propio objeto.
+*/
+#ifndef MDP_MAXIMUM_DIVERSITY_PROBLEM_H
+#define MDP_MAXIMUM_DIVERSITY_PROBLEM_H
+
+#include <cmath>
+#include <set>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "mdp.h"
+#include "minDiversity.h"
+#include "submatrix.h"
+#include "elitePool.h"
+#include "specialized.h"
+#include "trace.h"
+#include "frequencyMemory.h"
+#include "profiler.h"
+#include "scanPool.h"
+
+#define MU 0.3
+#define PHI 0.3
+#define ACC_HIGH 0.5       // Tasa de aceptacion a partir de la cual se acorta el nivel de temperatura
+#define ACC_LOW 0.05       // Tasa de aceptacion por debajo de la cual se alarga el nivel de temperatura
+#define FROZEN_PLATEAUS 3  // Niveles seguidos sin aceptar ningun vecino antes de recalentar
+#define CACHE_SIZE 1024    // Numero maximo de optimos locales que se recuerdan
+#define MIN_GAIN 1e-9      // Mejora minima de un intercambio, relativa a lo que aporta el que sale
+
+namespace mdp
+{
+
+//Semilla del arranque (o ejecucion) k: la 0 es la semilla original
+unsigned int seedFor(unsigned int seed, int k);
+
+class maximumDiversityProblem
+{
+    private:
+    //Problema compartido (solo lectura)
+    const Instance &data;
+
+    //Tamanio del conjunto de los datos
+    int n;
+
+    //Numero de elementos que tenemos que escoger del conjunto para generar la solucion
+    int m;
+
+    const Options &options;
+
+    //Conjunto solucion o seleccionados
+    std::set<int> bestSolution;
+
+    //Valor de la diversidad de la mejor solucion
+    double bestValue;
+
+    //Estado del generador de aleatorios propio de esta ejecucion
+    unsigned int seed;
+
+    //Claves de Zobrist: un valor aleatorio de 64 bits por elemento. El hash de una solucion es el
+    //xor de las claves de sus elementos, asi que un intercambio se actualiza con dos xor
+    std::vector<unsigned long long> zobrist;
+
+    //Solucion (y su valor) a la que baja la busqueda local desde cada solucion de partida con un
+    //maximo de budget evaluaciones, indexada por el hash de esta
+    struct cacheEntry
+    {
+        std::set<int> optimum;
+        double value;
+        int budget;
+    };
+    std::unordered_map<unsigned long long, cacheEntry> cache;
+
+    //Orden de insercion en la cache para descartar la entrada mas antigua cuando se llena
+    std::deque<unsigned long long> cacheOrder;
+
+    //Vecinos mas cercanos de la solucion actual para el objetivo Max-Min
+    minDiversity tracker;
+
+    //Submatriz de distancias de la solucion actual para MaxSum (busqueda local y enfriamiento)
+    submatrix selection;
+
+    //Nucleos para el m del problema y vector de trabajo para pasarles los elegidos de un set
+    const mKernels &kernels;
+    std::vector<int> scratch;
+
+    //Veces que cada elemento ha salido en los optimos de esta ejecucion (solo con options.memory)
+    frequencyMemory frequencies;
+
+    //Elementos cambiados desde el arranque en caliente: si focused, la siguiente busqueda local
+    //empieza probando solo los intercambios con alguno de ellos
+    bool focused;
+    std::vector<int> focus;
+
+    //Optimos locales para el reenlazado de caminos (solo con options.relinking)
+    elitePool elite;
+
+    //Anillo de la traza (nullptr = sin traza)
+    traceRing *ring;
+
+    //Contadores por fase (nullptr = sin options.profile)
+    std::unique_ptr<Profiler> profiler;
+
+    //Hilos con los que la busqueda local recorre cada pasada (setScanThreads). El pool se crea en la
+    //primera busqueda local MaxSum con trabajo suficiente para repartir
+    int scanThreads;
+    std::unique_ptr<scanPool> scanner;
+
+    //Pasada en paralelo: posiciones en sorted de los elegidos que se prueban y, por cada tarea (elegido
+    //y bloque de candidatos), la mayor contribucion (o cota) de sus candidatos
+    std::vector<int> scanPulls;
+    std::vector<double> scanBest;
+
+    //Umbral de los bits de no mirar de la busqueda local: un elegido no se prueba a sacar mientras su
+    //contribucion no baje de el (infinito = activo)
+    std::vector<double> threshold;
+
+    //Pasada (solucion) en la que cada elegido se probo sin encontrar mejora, y numero de pasadas
+    std::vector<int> checked;
+    int passes;
+
+    //Contadores de la ejecucion (skipped: elegidos que la busqueda local no probo por su bit de no mirar)
+    long long evaluations, skipped, cacheLookups, cacheHits;
+
+    //Devuelve un entero aleatorio en [0, RAND_MAX]
+    int random();
+
+    double distance(int i, int j) const { return data.getDistance(i, j); }
+
+    //Un intercambio de la busqueda local MaxSum mejora si delta supera MIN_GAIN relativo a cont2pull:
+    //dos candidatos empatados pueden dar delta > 0 los dos por redondeo y cambiarse entre si sin fin
+    static bool improves(double delta, double cont2pull) { return delta > MIN_GAIN * (1 + fabs(cont2pull)); }
+
+    //Devulve un vector con las soluciones ordenadas por su aportacion (selection debe seguir a solution)
+    std::vector<int> sortSolution(const std::set<int> &solution);
+
+    //Guarda en la cache la solucion alcanzada desde la solucion con hash key con budget evaluaciones
+    void cacheStore(unsigned long long key, const std::set<int> &optimum, double value, int budget);
+
+    //Valor de la solucion actual (que vale value) si se cambia out por in, segun el objetivo. El tracker
+    //(Max-Min) o la submatriz (MaxSum) deben seguir a la solucion
+    double swapValue(double value, int out, int in);
+
+    //Cambia out por in en solution y en el tracker o la submatriz
+    void applySwap(std::set<int> &solution, int out, int in);
+
+    //Busqueda local del primer mejor para Max-Min: solo se prueba a sacar los extremos de los pares a
+    //menor distancia, y cada candidato a entrar se descarta en cuanto se acerca demasiado a un elegido
+    std::set<int> findMaxMinLocalSearchSolution(std::set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter);
+
+    //Una pasada de la busqueda local MaxSum repartida entre los hilos: prueba a sacar los elegidos de
+    //sorted en orden (con los bits de no mirar del modo de la pasada) y se queda con el primer par
+    //(elegido, candidato) que mejora, como en serie. Devuelve su posicion en sorted, con item2push y
+    //delta, o sorted.size() si no hay; evaluated son los vecinos que habria evaluado en serie. Devuelve
+    //-1 sin cambiar nada si el presupuesto (budget vecinos) cortaria la pasada: se repite en serie
+    int parallelPass(const std::set<int> &solution, const std::vector<int> &sorted, bool verifying, int pass, int budget,
+                     int &item2push, double &delta, int &evaluated, bool &passSkipped);
+
+    //Busca un intercambio de mejora con algun elemento de changed y lo aplica. Devuelve false si no
+    //lo hay: si solution era un optimo local antes de los cambios lo sigue siendo
+    bool findFocusedSwap(std::set<int> &solution, double &solutionValue, unsigned long long &hash, const std::vector<int> &changed);
+
+    //Exhaustiva: prueba a completar chosen (que vale value) con elementos desde from
+    void enumerate(std::vector<int> &chosen, int from, double value);
+
+    //Avisa a options.progress de una solucion de valor value
+    void reportProgress(double value);
+
+    //Comunica la mejor solucion a las busquedas que cooperan (y a options.progress)
+    void publishBest();
+
+    //Si otra busqueda tiene una solucion mejor la adopta como mejor solucion. Devuelve true si cambia
+    bool receiveBest();
+
+    //Propone la solucion al conjunto elite si options.relinking
+    void offerElite(const std::set<int> &solution, double value, unsigned long long hash);
+
+    //Anota el optimo en la memoria de frecuencias si options.memory
+    void recordOptimum(const std::set<int> &solution);
+
+    public:
+
+    maximumDiversityProblem(const Instance &data, const Options &options, unsigned int seed);
+
+    //Reinicia el generador de aleatorios
+    void reseed(unsigned int seed);
+
+    //Hilos de la busqueda local (Options::scanThreads). Solo lo llama el Solver en sus busquedas
+    void setScanThreads(int threads) { scanThreads = threads; }
+
+    //Escribe los eventos de la busqueda en ring (solo con MDP_TRACE)
+    void setTrace(traceRing *ring) { this->ring = ring; }
+
+    //Encuentra la solucion por Busqueda Local. hash se mantiene actualizado con cada intercambio
+    std::set<int> findLocalSearchSolution(std::set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter);
+
+    //Busqueda local con cache: si ya se bajo desde esta solucion devuelve el optimo guardado
+    std::set<int> findCachedLocalSearchSolution(std::set<int> &solution, double &solutionValue, unsigned long long &hash, int maxIter);
+
+    //Busqueda Local desde una solucion aleatoria
+    std::set<int> findRandomLocalSearchSolution();
+
+    //Busqueda Multiarranque Basica con los arranques firstStart+first, +stride, ... (cada uno con su semilla)
+    std::set<int> findMultiStartSolution(int first, int stride);
+
+    //Busqueda Local Reiterada
+    std::set<int> findIteratedLocalSearch();
+
+    //Busqueda Local Reiterada usando Enfriamiento Simulado como busqueda
+    std::set<int> findIteratedSimAnnealing();
+
+    //Reenlazado de caminos: va de from hacia to cambiando cada vez el elemento que mas mejora y hace
+    //busqueda local desde el mejor punto intermedio. Devuelve true si mejora la mejor solucion
+    bool relinkPath(const std::set<int> &from, const std::set<int> &to);
+
+    //Busqueda de Vecindario Variable: agita la mejor solucion con un k-intercambio y baja con busqueda
+    //local; si mejora vuelve a k = 1 y si no pasa al k siguiente (hasta m/5)
+    std::set<int> findVariableNeighborhoodSearch();
+
+    //k-intercambio al azar sobre solution (con n > m), actualizando hash. contribution es la de cada
+    //elemento a solution antes del cambio; devuelve el nuevo valor, calculado en O(k^2) a partir de value
+    double shake(std::set<int> &solution, const std::vector<double> &contribution, double value, int k, unsigned long long &hash);
+
+    //Contribucion de cada elemento del problema a solution: O(n*m)
+    std::vector<double> contributionsTo(const std::set<int> &solution);
+
+    //Enfriamiento Simulado desde una solucion aleatoria
+    std::set<int> findRandomSimAnnealingSolution();
+
+    //Enfriamiento Simulado partiendo de solution, con esquema de enfriamiento adaptativo
+    std::set<int> findSimAnnealingSolution(std::set<int> &solution, double &value, int maxEvaluations);
+
+    //Greedy: empieza por el elemento con mayor suma de distancias y anade cada vez el que mas aporta a
+    //los elegidos, manteniendo las aportaciones de todos: O(n*m). Con options.polish hace despues una
+    //pasada de intercambios (el mejor para cada elegido) con las mismas aportaciones
+    std::set<int> findGreedySolution();
+
+    //Busqueda exhaustiva: recorre los C(n,m) subconjuntos con el valor de cada prefijo, O(C(n,m)*m).
+    //Solo para problemas pequenios. Con varios hilos, el hilo first de stride recorre los subconjuntos
+    //cuyo menor elemento es first, first+stride...
+    std::set<int> findExhaustiveSolution(int first = 0, int stride = 1);
+
+    std::set<int> randomSolution();
+
+    //m elementos distintos muestreados de la memoria de frecuencias
+    std::set<int> memorySolution();
+
+    //Construccion GRASP: en cada paso elige al azar entre los candidatos cuya contribucion a los ya
+    //elegidos esta dentro de alpha del mejor. Las contribuciones se actualizan al anadir cada elemento: O(n*m)
+    std::set<int> graspSolution();
+
+    //Solucion de partida segun options.construction
+    std::set<int> initialSolution();
+
+    //Arranque en caliente desde options.start, completado con los que mas aportan si le faltan elementos
+    std::set<int> warmSolution();
+
+    //Devuelve la contribucion (o suma acumulada de distancias) del elemento i a los elementos del conjunto sol
+    double getContribution(int i, const std::set<int> &set);
+
+    // Calcula la diversidad entre los elementos seleccionados segun el objetivo (MaxSum o Max-Min)
+    double evaluation();
+
+    double evaluation(const std::set<int> &sol);
+
+    //Perturba m/10 elementos de la solucion actualizando su valor y su hash
+    std::set<int> mutate(std::set<int> &solution, double &value, unsigned long long &hash);
+
+    // Genera un vecino aleatorio del sol: el intercambio de item2pull (elegido) por item2push
+    void randomNeighbor(const std::set<int> &sol, int &item2pull, int &item2push);
+
+    //Hash de Zobrist de la solucion completa
+    unsigned long long hashSolution(const std::set<int> &sol);
+
+    const std::set<int> &getBestSolution() const { return bestSolution; }
+
+    double getBestValue() const { return bestValue; }
+
+    const elitePool &getElite() const { return elite; }
+
+    long long getEvaluations() const { return evaluations; }
+
+    long long getSkipped() const { return skipped; }
+
+    //nullptr sin options.profile
+    const Profiler *getProfiler() const { return profiler.get(); }
+
+    long long getCacheLookups() const { return cacheLookups; }
+
+    long long getCacheHits() const { return cacheHits; }
+};
+
+}
+
+#endif
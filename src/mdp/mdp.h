@@ -0,0 +1,442 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    libmdp: resolucion del Problema de la Maxima Diversidad (MDP) como biblioteca.
+
+    - Instance: problema leido de fichero (o construido en memoria). Es inmutable, asi que un
+      mismo objeto se puede compartir entre todos los hilos que resuelven sobre el.
+    - Solver: una ejecucion con sus opciones (algoritmo, semilla, presupuesto, hilos). Cada Solver
+      tiene su propio generador de aleatorios, no usa rand() ni estado global.
+    - Result: valor, elementos seleccionados, tiempo y contadores de la ejecucion.
+*/
+#ifndef MDP_H
+#define MDP_H
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mdp
+{
+
+// Distribucion de las distancias de un problema generado (Instance::generate)
+enum Distribution
+{
+    UNIFORM_DISTANCES,          // Uniformes en [0, 10] con dos decimales, como MDG-a
+    EUCLIDEAN_DISTANCES,        // Puntos uniformes en el cuadrado [0, 100]^2
+    CLUSTERED_DISTANCES         // Puntos en grupos gaussianos alrededor de unos centros al azar
+};
+
+// Cambios sobre un problema ya cargado. Se usan las etiquetas del fichero; las distancias de un
+// elemento nuevo que no se dan valen 0, como en el fichero
+struct Delta
+{
+    struct Element
+    {
+        int label;
+        std::vector<std::pair<int, double>> distances;
+    };
+
+    struct Change
+    {
+        int i, j;
+        double distance;
+    };
+
+    //Se aplican en este orden: se quitan, se anaden y se cambian distancias
+    std::vector<int> removed;
+    std::vector<Element> added;
+    std::vector<Change> changed;
+
+    bool empty() const { return removed.empty() && added.empty() && changed.empty(); }
+
+    //Etiquetas de los elementos cuyas distancias cambian (para Options::changed)
+    std::vector<int> labels() const;
+};
+
+// Matriz de distancias de un problema y numero de elementos a escoger, con estadisticas por
+// elemento calculadas al construirlo. Los elementos pueden estar reetiquetados (reorder): getLabel
+// devuelve la etiqueta del fichero y Result siempre usa las etiquetas del fichero
+class Instance
+{
+    private:
+    //Tamanio del conjunto de los datos
+    int n;
+
+    //Numero de elementos que tenemos que escoger del conjunto para generar la solucion
+    int m;
+
+    //Matriz de distancias n*n por filas (simetrica para trabajar sin complicaciones). Las filas
+    //tienen stride posiciones reservadas para poder anadir elementos sin mover la matriz
+    std::vector<double> distances;
+    int stride;
+
+    //Etiqueta en el fichero de cada elemento y posicion de cada etiqueta
+    std::vector<int> labels, positions;
+
+    //Suma de la fila, mayor distancia y suma de las m-1 mayores distancias de cada elemento. Tras
+    //apply las dos ultimas solo son exactas en los elementos nombrados en el cambio; en el resto
+    //se actualizan en O(1) como cotas superiores
+    std::vector<double> rowSums, maxDistances, topSums;
+
+    //Cota superior de la diversidad de cualquier solucion
+    double upperBound;
+
+    //Recalcula las estadisticas del elemento i: O(n)
+    void computeStats(int i);
+
+    void computeUpperBound();
+
+    //Cambia la distancia entre i y j manteniendo las sumas y las cotas de las dos filas
+    void setDistance(int i, int j, double value);
+
+    //Quita el elemento i llevando el ultimo a su posicion: O(n)
+    void removeElement(int i);
+
+    //Anade un elemento con todas sus distancias a 0 y devuelve su posicion: O(n), salvo cuando hay
+    //que ampliar la reserva de la matriz
+    int addElement(int label);
+
+    public:
+
+    //distances es la matriz completa n*n por filas y debe ser simetrica. labels (opcional) es la
+    //etiqueta original de cada elemento
+    Instance(int n, int m, std::vector<double> distances, std::vector<int> labels = std::vector<int>());
+
+    //Lee un fichero con el formato "n m" seguido de lineas "i j distancia", o en el formato binario de
+    //save (se reconoce por su marca). Devuelve nullptr si no se puede leer
+    static std::shared_ptr<Instance> load(const std::string &path);
+
+    //Escribe el problema en el formato de texto o en binario (marca "MDPB", n, m, la mitad superior de
+    //la matriz en double, que se lee sin convertir texto, y las etiquetas). En texto los elementos se
+    //escriben con su posicion, no con su etiqueta. Devuelve false si no se puede escribir
+    bool save(const std::string &path, bool binary) const;
+
+    //Problema sintetico de n elementos con distancias segun distribution, reproducible con seed
+    static std::shared_ptr<Instance> generate(int n, int m, Distribution distribution, unsigned int seed);
+
+    //Copia con los elementos reetiquetados por suma de distancias decreciente: los que mas aportan (y
+    //mas se eligen) quedan al principio y la submatriz de una buena solucion queda compacta en memoria
+    std::shared_ptr<Instance> reorder() const;
+
+    //Problema con solo los elementos dados (posiciones, en ese orden) y sus etiquetas del fichero
+    std::shared_ptr<Instance> subset(const std::vector<int> &elements) const;
+
+    //Aplica los cambios sobre el propio problema con un coste proporcional a su tamanio (O(n) por
+    //elemento nombrado), no al del problema. Los elementos nuevos van al final. Devuelve false y no
+    //cambia nada si el cambio no es valido (etiquetas que no existen o repetidas, menos de m elementos).
+    //No se puede llamar mientras un Solver resuelve sobre este problema
+    bool apply(const Delta &delta);
+
+    int getN() const { return n; }
+
+    int getM() const { return m; }
+
+    double getDistance(int i, int j) const { return distances[(size_t) i * stride + j]; }
+
+    //Fila i de la matriz de distancias (n valores contiguos)
+    const double *getRow(int i) const { return distances.data() + (size_t) i * stride; }
+
+    //Etiqueta del fichero del elemento i, y elemento con la etiqueta label
+    int getLabel(int i) const { return labels[i]; }
+
+    //-1 si no hay ningun elemento con esa etiqueta (o se ha quitado)
+    int getPosition(int label) const { return label >= 0 && label < (int) positions.size() ? positions[label] : -1; }
+
+    double getRowSum(int i) const { return rowSums[i]; }
+
+    double getMaxDistance(int i) const { return maxDistances[i]; }
+
+    //Cota de la contribucion de i a cualquier conjunto de m-1 elementos
+    double getContributionBound(int i) const { return topSums[i]; }
+
+    //Cota superior de la diversidad: la mitad de la suma de las m mayores cotas de contribucion
+    double getUpperBound() const { return upperBound; }
+};
+
+enum Algorithm
+{
+    LOCAL_SEARCH,               // Busqueda local desde una solucion aleatoria
+    MULTI_START,                // busquedaMultiBasica
+    ITERATED_LOCAL_SEARCH,      // busquedaLocalReiterada
+    ITERATED_SIM_ANNEALING,     // busquedaLocalReiterada-ES
+    SIM_ANNEALING,              // enfriamientoSimulado
+    GREEDY,                     // greedy: el mas lejano a los elegidos, determinista
+    EXHAUSTIVE,                 // exhaustiva: todos los subconjuntos, exacta (solo para n pequenio)
+    BRANCH_AND_BOUND,           // exacta: ramificacion y poda en paralelo (n <= 256; con Max-Min, exhaustiva)
+    MEMETIC,                    // algoritmoMemetico: estacionario, los hijos se mejoran en paralelo
+    VARIABLE_NEIGHBORHOOD       // busquedaVecindarioVariable: k-intercambios con k adaptativo
+};
+
+//Como se construyen las soluciones de partida de la multiarranque y de las reiteradas
+enum Construction
+{
+    RANDOM_CONSTRUCTION,        // m elementos al azar
+    GRASP_CONSTRUCTION          // Greedy aleatorizado con lista restringida de candidatos
+};
+
+//Funcion objetivo
+enum Objective
+{
+    MAX_SUM,                    // Suma de las distancias entre los elegidos
+    MAX_MIN                     // Menor distancia entre dos elegidos
+};
+
+//Traduce el nombre del ejecutable (busquedaMultiBasica, enfriamientoSimulado, greedy...), busquedaLocal, exhaustiva o exacta
+//al algoritmo. Devuelve false si no es ninguno
+bool parseAlgorithm(const std::string &name, Algorithm &algorithm);
+
+//Intercambio de la mejor solucion con otras busquedas (otros hilos o procesos). Si se usa con
+//varios hilos la implementacion debe ser segura entre hilos
+class Cooperation
+{
+    public:
+    virtual ~Cooperation() {}
+
+    //Las soluciones usan las etiquetas del fichero. Se llama cada vez que la busqueda mejora su mejor solucion
+    virtual void publish(double value, const std::vector<int> &solution) = 0;
+
+    //Devuelve true (y la solucion) si se conoce una solucion mejor que value para continuar desde ella
+    virtual bool receive(double &value, std::vector<int> &solution) = 0;
+};
+
+//Seguimiento de la calidad en el tiempo (para medir la convergencia). Si se usa con varios hilos la
+//implementacion debe ser segura entre hilos
+class Progress
+{
+    public:
+    virtual ~Progress() {}
+
+    //Se llama cuando la busqueda alcanza una solucion de valor value (no tiene por que mejorar lo
+    //anterior: el enfriamiento dentro de la reiterada avisa de sus propias mejoras)
+    virtual void improved(double value) = 0;
+};
+
+//Fases de una resolucion que se miden con Options::profile
+enum Phase
+{
+    READ_PHASE,                 // Lectura y reetiquetado del problema (la mide el ejecutable)
+    CONSTRUCTION_PHASE,         // Cada solucion de partida (aleatoria, GRASP, memoria o en caliente)
+    DESCENT_PHASE,              // Cada busqueda local
+    PLATEAU_PHASE,              // Cada nivel de temperatura del enfriamiento
+    PERTURBATION_PHASE,         // Cada perturbacion de las reiteradas y del vecindario variable
+    NUM_PHASES
+};
+
+//Contadores acumulados de una fase. Los de hardware valen -1 si no se pudieron abrir
+struct PhaseCounters
+{
+    long long calls = 0;
+    long long nanoseconds = 0;
+
+    //Vecinos evaluados dentro de la fase
+    long long moves = 0;
+
+    long long cycles = -1, instructions = -1;
+    long long l1Misses = -1, llcMisses = -1, branchMisses = -1;
+
+    void add(const PhaseCounters &other);
+};
+
+//Mide fases del hilo que lo usa con perf_event_open (ciclos, instrucciones, fallos de L1 de datos y
+//de ultimo nivel, fallos de prediccion de saltos). Los contadores se abren en el primer begin de cada
+//hilo y solo cuentan ese hilo; si no se pueden abrir (contenedor, perf_event_paranoid) solo se miden
+//tiempos. Las fases no se anidan
+class Profiler
+{
+    private:
+    //Grupo de contadores (-1 si no hay) y a que campo de PhaseCounters va cada valor del grupo
+    int group;
+    std::vector<int> fds;
+    std::vector<int> fields;
+
+    //Hilo para el que se abrieron los contadores
+    std::size_t owner;
+    bool opened;
+
+    long long startTime;
+    std::vector<long long> startValues, values;
+
+    std::vector<PhaseCounters> phases;
+
+    void open();
+
+    void close();
+
+    //Lee el grupo en values (escalado si el nucleo lo ha multiplexado). false si no se puede
+    bool read();
+
+    public:
+
+    Profiler();
+
+    ~Profiler();
+
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    bool hasCounters() const { return group >= 0; }
+
+    void begin(Phase phase);
+
+    //Cierra la fase que empezo en begin, que evaluo moves vecinos
+    void end(Phase phase, long long moves = 0);
+
+    //NUM_PHASES contadores, por fase
+    const std::vector<PhaseCounters> &getPhases() const { return phases; }
+};
+
+struct Options
+{
+    Algorithm algorithm = ITERATED_LOCAL_SEARCH;
+
+    unsigned int seed = 0;
+
+    //Maximo de evaluaciones de cada busqueda local o enfriamiento (0 = el de cada ejecutable)
+    int budget = 0;
+
+    //Hilos: en la multiarranque se reparten los arranques y en el memetico las busquedas locales de
+    //los hijos (el resultado no depende de los hilos); en el resto se lanzan tantas
+    //ejecuciones independientes como hilos (semillas distintas) y se devuelve la mejor
+    int threads = 1;
+
+    //Ramificacion y poda: segundos como mucho (0 = sin limite). Al cortar, Result::bound acota el optimo
+    double timeLimit = 0;
+
+    //Arranques de la multiarranque, iteraciones de la reiterada y del vecindario variable o generaciones
+    //del memetico
+    int starts = 10;
+
+    //Indice del primer arranque. El arranque k usa su propia semilla derivada de seed, asi que con
+    //firstStart = k y starts = 1 se repite exactamente el arranque k de la ejecucion completa. En el
+    //resto de algoritmos el hilo w usa la semilla del arranque firstStart + w
+    int firstStart = 0;
+
+    //Opcional: intercambio de la mejor solucion con otras busquedas (reiteradas y multiarranque)
+    Cooperation *cooperation = nullptr;
+
+    //Opcional: aviso de cada mejora
+    Progress *progress = nullptr;
+
+    Construction construction = RANDOM_CONSTRUCTION;
+
+    //GRASP: un candidato entra en la lista restringida si su contribucion es al menos
+    //cmax - alpha * (cmax - cmin). 0 = voraz puro, 1 = aleatorio puro
+    double alpha = 0.3;
+
+    //Greedy: tras construir la solucion hace una pasada de intercambios de mejora
+    bool polish = false;
+
+    //Niveles de temperatura sin mejora tras los que para el enfriamiento (0 = nunca)
+    int maxStall = 15;
+
+    Objective objective = MAX_SUM;
+
+    //Memoria de frecuencias: los arranques aleatorios y las perturbaciones de las reiteradas prefieren
+    //elementos con cota de contribucion alta que hayan salido poco en los optimos ya encontrados. Con
+    //varios hilos cada uno tiene su memoria, asi que la multiarranque depende del reparto de arranques
+    bool memory = false;
+
+    //Reduccion del problema: los algoritmos buscan solo en un nucleo de reduction*m candidatos (los
+    //que mas salen en unas construcciones voraces y GRASP rapidas y, despues, los de mayor suma de
+    //distancias) y al final una busqueda local sobre el problema completo deja un optimo local de
+    //este. 0 = sin reduccion; no se aplica a las exactas, al greedy ni si el nucleo no es menor que n
+    int reduction = 0;
+
+    //Hilos con los que cada busqueda local MaxSum se reparte sus pasadas. El intercambio elegido es el
+    //mismo que con uno (el primero que mejora, en el orden de la pasada), asi que el resultado no
+    //cambia. Solo se crean si (n-m)*m >= SCAN_MIN_WORK y no en el memetico; se suman a los de threads
+    int scanThreads = 1;
+
+    //Mide las fases de las busquedas en Result::phases (salvo memetico, greedy y exactas)
+    bool profile = false;
+
+    //Fichero de traza binaria de las busquedas (vacio = sin traza). Solo si libmdp se ha compilado
+    //con MDP_TRACE (make TRACE=1); se pasa a CSV con exportTrace
+    std::string trace;
+
+    //Multiarranque y reiteradas: guarda los mejores optimos locales distintos y al terminar reenlaza
+    //cada par (del mejor al peor) en paralelo, con busqueda local en el mejor punto de cada camino
+    bool relinking = false;
+
+    //Arranque en caliente: solucion de partida (etiquetas del fichero), normalmente la de la
+    //resolucion anterior. Si le faltan elementos (se han quitado) se completa con los que mas aportan.
+    //La usan la busqueda local, las reiteradas, el enfriamiento y el primer arranque de la multiarranque
+    std::vector<int> start;
+
+    //Etiquetas de los elementos cambiados desde que se obtuvo start (Delta::labels). Si start era un
+    //optimo local y sigue completa, la primera busqueda local solo prueba los intercambios con algun
+    //elemento cambiado: si ninguno mejora sigue siendo optimo local, sin recorrer todo el vecindario
+    std::vector<int> changed;
+};
+
+//Quita de los argumentos de un ejecutable las opciones que empiezan por "--" y las aplica a
+//options. Devuelve el resto de argumentos (argv[0] incluido) en orden:
+//  --maxmin    objetivo Max-Min
+//  --reenlazar reenlazado de caminos entre las mejores soluciones (Options::relinking)
+//  --traza=fichero traza binaria de las busquedas (Options::trace); sin MDP_TRACE avisa y se ignora
+//  --nucleo=k  busqueda en un nucleo de k*m candidatos (Options::reduction)
+//  --memoria   memoria de frecuencias en arranques y perturbaciones (Options::memory)
+//  --perfil    contadores por fase (Options::profile)
+//  --barrido=h busqueda local con h hilos por paso (Options::scanThreads)
+std::vector<std::string> parseArguments(int argc, char const *argv[], Options &options);
+
+struct Result
+{
+    //Diversidad de la solucion segun el objetivo
+    double value = -1.0;
+
+    //Elementos seleccionados (etiquetas del fichero) en orden creciente
+    std::vector<int> solution;
+
+    //Cota superior de la diversidad MaxSum del problema (Instance::getUpperBound). 0 con Max-Min. Con
+    //ramificacion y poda es la cota de lo que quedo sin explorar: igual a value si se termino
+    double bound = 0;
+
+    //Tiempo de la resolucion
+    long long microseconds = 0;
+
+    //Vecinos evaluados (intercambios en busqueda local, vecinos en enfriamiento, nodos en ramificacion y poda)
+    long long evaluations = 0;
+
+    //Elegidos que la busqueda local no volvio a probar a sacar por su bit de no mirar
+    long long skipped = 0;
+
+    //Consultas y aciertos de la cache de optimos locales
+    long long cacheLookups = 0;
+    long long cacheHits = 0;
+
+    //Con Options::profile, NUM_PHASES contadores sumando todos los hilos; vacio si no
+    std::vector<PhaseCounters> phases;
+};
+
+//Escribe una linea por fase medida: veces, ms, vecinos, IPC y fallos por vecino evaluado ("-" si no
+//hay contadores de hardware o la fase no evalua vecinos)
+void writeProfile(std::ostream &out, const std::vector<PhaseCounters> &phases);
+
+//Escribe en csv la traza binaria del fichero path (una linea por registro, tiempo en us desde el
+//principio). Devuelve los registros que se descartaron al trazar, o -1 si no es un fichero de traza
+long long exportTrace(const std::string &path, std::ostream &csv);
+
+class Solver
+{
+    private:
+    std::shared_ptr<const Instance> instance;
+
+    Options options;
+
+    //Resuelve en el nucleo de options.reduction*m candidatos y pule en el problema completo
+    Result solveReduced() const;
+
+    public:
+
+    Solver(std::shared_ptr<const Instance> instance, const Options &options);
+
+    //Resuelve el problema. Se puede llamar varias veces: con las mismas opciones da el mismo resultado
+    Result solve() const;
+};
+
+}
+
+#endif
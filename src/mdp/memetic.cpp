@@ -0,0 +1,259 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "memetic.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace mdp
+{
+
+memeticSearch::memeticSearch(const Instance &data, const Options &options):
+    data(data), options(options), n(data.getN()), m(data.getM()), words((data.getN() + 63) / 64), seed(options.seed)
+{
+    members.assign((size_t) MEMETIC_POPULATION * words, 0);
+    contributions.assign((size_t) MEMETIC_POPULATION * n, 0.0);
+    values.assign(MEMETIC_POPULATION, -1.0);
+    hashes.assign(MEMETIC_POPULATION, 0);
+
+    int threads = max(options.threads, 1);
+    for(int w=0; w < threads; w++){
+        searches.emplace_back(new maximumDiversityProblem(data, options, seedFor(options.seed, w)));
+    }
+}
+
+int memeticSearch::random()
+{
+    return rand_r(&seed);
+}
+
+void memeticSearch::store(int p, const set<int> &sol, double value, unsigned long long hash)
+{
+    unsigned long long *bits = members.data() + (size_t) p * words;
+    double *contribution = contributions.data() + (size_t) p * n;
+
+    fill(bits, bits + words, 0);
+    fill(contribution, contribution + n, 0.0);
+
+    for(int i : sol){
+        bits[i >> 6] |= 1ULL << (i & 63);
+
+        const double *row = data.getRow(i);
+        for(int j=0; j < n; j++){
+            contribution[j] += row[j];
+        }
+    }
+
+    values[p] = value;
+    hashes[p] = hash;
+}
+
+set<int> memeticSearch::decode(int p) const
+{
+    set<int> sol;
+    const unsigned long long *bits = members.data() + (size_t) p * words;
+
+    for(int w=0; w < words; w++){
+        for(unsigned long long b = bits[w]; b; b &= b - 1){
+            sol.insert(w * 64 + __builtin_ctzll(b));
+        }
+    }
+
+    return sol;
+}
+
+int memeticSearch::select()
+{
+    int a = random() % MEMETIC_POPULATION;
+    int b = random() % MEMETIC_POPULATION;
+
+    return values[a] >= values[b] ? a : b;
+}
+
+set<int> memeticSearch::crossover(int a, int b)
+{
+    set<int> child;
+    vector<int> onlyA, rest;
+
+    for(int i=0; i < n; i++){
+        bool inA = contains(a, i), inB = contains(b, i);
+        if(inA && inB){
+            child.insert(i);
+        }else if(inA){
+            onlyA.push_back(i);
+            rest.push_back(i);
+        }else if(inB){
+            rest.push_back(i);
+        }
+    }
+
+    // Contribuciones a los comunes. MaxSum: las de a menos las filas de los que solo estan en a.
+    // Max-Min: la menor distancia a los comunes (sin comunes, todas iguales)
+    const bool maxMin = options.objective == MAX_MIN;
+    vector<double> contribution(n, 0.0);
+    if(maxMin){
+        if(!child.empty()){
+            fill(contribution.begin(), contribution.end(), HUGE_VAL);
+        }
+        for(int i : child){
+            const double *row = data.getRow(i);
+            for(int j=0; j < n; j++){
+                contribution[j] = min(contribution[j], row[j]);
+            }
+        }
+    }else{
+        const double *contributionA = contributions.data() + (size_t) a * n;
+        contribution.assign(contributionA, contributionA + n);
+        for(int i : onlyA){
+            const double *row = data.getRow(i);
+            for(int j=0; j < n; j++){
+                contribution[j] -= row[j];
+            }
+        }
+    }
+
+    // GRASP entre los que solo estan en uno de los padres
+    while((int) child.size() < m){
+        double cmax = -HUGE_VAL, cmin = HUGE_VAL;
+        for(int j : rest){
+            cmax = max(cmax, contribution[j]);
+            cmin = min(cmin, contribution[j]);
+        }
+
+        const double threshold = cmax - options.alpha * (cmax - cmin);
+        vector<int> rcl;
+        for(int j : rest){
+            if(contribution[j] >= threshold){
+                rcl.push_back(j);
+            }
+        }
+
+        int item = rcl[random() % rcl.size()];
+        bool first = child.empty();
+        child.insert(item);
+        rest.erase(find(rest.begin(), rest.end(), item));
+
+        const double *row = data.getRow(item);
+        for(int j : rest){
+            if(!maxMin){
+                contribution[j] += row[j];
+            }else{
+                contribution[j] = first ? row[j] : min(contribution[j], row[j]);
+            }
+        }
+    }
+
+    return child;
+}
+
+void memeticSearch::improve(vector<set<int>> &batch, vector<double> &batchValues, vector<unsigned long long> &batchHashes)
+{
+    const int maxIter = options.budget > 0 ? options.budget : 10000;
+    const int threads = searches.size();
+
+    batchValues.assign(batch.size(), 0.0);
+    batchHashes.assign(batch.size(), 0);
+
+    // Cada hilo coge la siguiente solucion sin mejorar; la busqueda local no usa aleatorios
+    atomic<int> next(0);
+    auto work = [&](int w){
+        maximumDiversityProblem &search = *searches[w];
+        for(int k = next++; k < (int) batch.size(); k = next++){
+            batchHashes[k] = search.hashSolution(batch[k]);
+            search.findLocalSearchSolution(batch[k], batchValues[k], batchHashes[k], maxIter);
+        }
+    };
+
+    vector<thread> workers;
+    for(int w=1; w < threads && w < (int) batch.size(); w++){
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for(thread &worker : workers){
+        worker.join();
+    }
+}
+
+Result memeticSearch::solve()
+{
+    Result result;
+    auto start = high_resolution_clock::now();
+
+    // Poblacion inicial: soluciones de partida (cada una con su semilla) mejoradas con busqueda local
+    vector<set<int>> batch(MEMETIC_POPULATION);
+    vector<double> batchValues;
+    vector<unsigned long long> batchHashes;
+
+    for(int p=0; p < MEMETIC_POPULATION; p++){
+        searches[0]->reseed(seedFor(options.seed, p));
+        batch[p] = searches[0]->initialSolution();
+    }
+    improve(batch, batchValues, batchHashes);
+
+    int best = 0;
+    for(int p=0; p < MEMETIC_POPULATION; p++){
+        store(p, batch[p], batchValues[p], batchHashes[p]);
+        if(values[p] > values[best]){
+            best = p;
+        }
+    }
+    if(options.progress){
+        options.progress->improved(values[best]);
+    }
+
+    for(int g=0; g < options.starts; g++){
+        batch.resize(MEMETIC_OFFSPRING);
+        for(int k=0; k < MEMETIC_OFFSPRING; k++){
+            batch[k] = crossover(select(), select());
+        }
+        improve(batch, batchValues, batchHashes);
+
+        // Reemplazo en orden: el hijo entra en lugar del peor si es mejor y no esta ya
+        for(int k=0; k < MEMETIC_OFFSPRING; k++){
+            if(find(hashes.begin(), hashes.end(), batchHashes[k]) != hashes.end()){
+                continue;
+            }
+
+            int worst = min_element(values.begin(), values.end()) - values.begin();
+            if(batchValues[k] > values[worst]){
+                store(worst, batch[k], batchValues[k], batchHashes[k]);
+
+                if(values[worst] > values[best]){
+                    best = worst;
+                    if(options.progress){
+                        options.progress->improved(values[best]);
+                    }
+                }
+            }
+        }
+    }
+
+    auto stop = high_resolution_clock::now();
+    result.microseconds = duration_cast<microseconds>(stop - start).count();
+
+    set<int> bestSolution = decode(best);
+    for(int i : bestSolution){
+        result.solution.push_back(data.getLabel(i));
+    }
+    sort(result.solution.begin(), result.solution.end());
+
+    result.value = searches[0]->evaluation(bestSolution);
+    result.bound = options.objective == MAX_SUM ? data.getUpperBound() : 0;
+    for(auto &search : searches){
+        result.evaluations += search->getEvaluations();
+        result.skipped += search->getSkipped();
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,82 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Algoritmo memetico estacionario (uso interno de libmdp). La poblacion se guarda por columnas en
+    un solo bloque: los elegidos de cada individuo como bits, su vector de contribuciones (lo que
+    aporta cada elemento del problema a su solucion), su valor y su hash. En cada generacion se
+    cruzan MEMETIC_OFFSPRING parejas, los hijos se mejoran con busqueda local en paralelo y cada hijo
+    sustituye al peor individuo si lo mejora y no esta repetido.
+
+    El cruce conserva los elementos comunes a los dos padres y completa con GRASP entre los que solo
+    estan en uno de ellos. Las contribuciones del hijo a los comunes salen de las del padre restando
+    las filas de los que no comparte: cuesta O(n) por elemento distinto, y al converger la poblacion
+    los padres se parecen cada vez mas.
+*/
+#ifndef MDP_MEMETIC_H
+#define MDP_MEMETIC_H
+
+#include <set>
+#include <vector>
+#include <memory>
+
+#include "mdp.h"
+#include "maximumDiversityProblem.h"
+
+#define MEMETIC_POPULATION 20      // Individuos de la poblacion
+#define MEMETIC_OFFSPRING 4        // Hijos por generacion (se mejoran en paralelo)
+
+namespace mdp
+{
+
+class memeticSearch
+{
+    private:
+    const Instance &data;
+    const Options &options;
+    int n, m;
+
+    //Palabras de 64 bits por individuo
+    int words;
+
+    //Poblacion por columnas: individuo p ocupa members[p*words..], contributions[p*n..]
+    std::vector<unsigned long long> members;
+    std::vector<double> contributions;
+    std::vector<double> values;
+    std::vector<unsigned long long> hashes;
+
+    //Una busqueda local por hilo (cada una con sus contadores)
+    std::vector<std::unique_ptr<maximumDiversityProblem>> searches;
+
+    //Generador del cruce y la seleccion (en el hilo principal, para que el resultado no dependa de los hilos)
+    unsigned int seed;
+
+    int random();
+
+    bool contains(int p, int i) const { return (members[(size_t) p * words + (i >> 6)] >> (i & 63)) & 1; }
+
+    //Guarda sol (de valor value y hash hash) como individuo p y calcula sus contribuciones: O(n*m)
+    void store(int p, const std::set<int> &sol, double value, unsigned long long hash);
+
+    std::set<int> decode(int p) const;
+
+    //Torneo binario: el mejor de dos individuos al azar
+    int select();
+
+    //Hijo de a y b: comunes, y GRASP entre los del resto de la union por su contribucion a los elegidos
+    //segun el objetivo (suma de distancias o, con Max-Min, la menor)
+    std::set<int> crossover(int a, int b);
+
+    //Mejora cada solucion de batch con busqueda local, repartiendo entre los hilos
+    void improve(std::vector<std::set<int>> &batch, std::vector<double> &batchValues, std::vector<unsigned long long> &batchHashes);
+
+    public:
+
+    memeticSearch(const Instance &data, const Options &options);
+
+    //options.starts generaciones con options.threads hilos
+    Result solve();
+};
+
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <iterator>
+
+#include <math.h>
+
+#include "minDiversity.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+minDiversity::minDiversity(const Instance &data):data(data)
+{
+    int n = data.getN();
+
+    selected.assign(n, false);
+    nearest.assign(n, -1);
+    second.assign(n, -1);
+    nearestDistance.assign(n, HUGE_VAL);
+    secondDistance.assign(n, HUGE_VAL);
+}
+
+void minDiversity::init(const set<int> &sol)
+{
+    for(int s : members){
+        selected[s] = false;
+    }
+
+    members.assign(sol.begin(), sol.end());
+    for(int s : members){
+        selected[s] = true;
+    }
+
+    for(int s : members){
+        refresh(s);
+    }
+}
+
+void minDiversity::refresh(int s)
+{
+    const double *row = data.getRow(s);
+
+    nearest[s] = second[s] = -1;
+    nearestDistance[s] = secondDistance[s] = HUGE_VAL;
+
+    for(int t : members){
+        if(t == s){
+            continue;
+        }
+
+        if(row[t] < nearestDistance[s]){
+            second[s] = nearest[s];
+            secondDistance[s] = nearestDistance[s];
+            nearest[s] = t;
+            nearestDistance[s] = row[t];
+        }else if(row[t] < secondDistance[s]){
+            second[s] = t;
+            secondDistance[s] = row[t];
+        }
+    }
+}
+
+double minDiversity::value() const
+{
+    if(members.size() < 2){
+        return 0;
+    }
+
+    double value = HUGE_VAL;
+    for(int s : members){
+        if(nearestDistance[s] < value){
+            value = nearestDistance[s];
+        }
+    }
+
+    return value;
+}
+
+double minDiversity::valueWithout(int out) const
+{
+    double value = HUGE_VAL;
+
+    for(int s : members){
+        if(s != out){
+            double d = nearest[s] == out ? secondDistance[s] : nearestDistance[s];
+            if(d < value){
+                value = d;
+            }
+        }
+    }
+
+    return value;
+}
+
+double minDiversity::distanceTo(int in, int out) const
+{
+    const double *row = data.getRow(in);
+    double value = HUGE_VAL;
+
+    for(int s : members){
+        if(s != out && row[s] < value){
+            value = row[s];
+        }
+    }
+
+    return value;
+}
+
+double minDiversity::swapValue(int out, int in) const
+{
+    if(members.size() < 2){
+        return 0;
+    }
+
+    double rest = valueWithout(out);
+    double added = distanceTo(in, out);
+
+    return rest < added ? rest : added;
+}
+
+void minDiversity::swap(int out, int in)
+{
+    if(out == in){
+        return;
+    }
+
+    for(int &s : members){
+        if(s == out){
+            s = in;
+        }
+    }
+    selected[out] = false;
+    selected[in] = true;
+
+    const double *row = data.getRow(in);
+
+    for(int s : members){
+        if(s == in){
+            continue;
+        }
+
+        if(nearest[s] == out || second[s] == out){
+            refresh(s);
+        }else if(row[s] < nearestDistance[s]){
+            second[s] = nearest[s];
+            secondDistance[s] = nearestDistance[s];
+            nearest[s] = in;
+            nearestDistance[s] = row[s];
+        }else if(row[s] < secondDistance[s]){
+            second[s] = in;
+            secondDistance[s] = row[s];
+        }
+    }
+
+    refresh(in);
+}
+
+vector<int> minDiversity::critical() const
+{
+    double min = value();
+    vector<int> critical;
+
+    for(int s : members){
+        if(nearestDistance[s] == min){
+            critical.push_back(s);
+        }
+    }
+
+    return critical;
+}
+
+double minDistance(const Instance &data, const set<int> &sol)
+{
+    if(sol.size() < 2){
+        return 0;
+    }
+
+    double value = HUGE_VAL;
+
+    for(auto it = sol.begin(); it != sol.end(); it++){
+        const double *row = data.getRow(*it);
+        for(auto sub_it = next(it,1); sub_it != sol.end(); sub_it++){
+            if(row[*sub_it] < value){
+                value = row[*sub_it];
+            }
+        }
+    }
+
+    return value;
+}
+
+}
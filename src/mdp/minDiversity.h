@@ -0,0 +1,68 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Objetivo Max-Min (uso interno de libmdp): la diversidad es la menor distancia entre dos elegidos.
+    Para no recalcular las m*m distancias en cada movimiento se guarda, para cada elegido, su vecino
+    elegido mas cercano y el segundo mas cercano (para saber que pasa si sale el primero).
+*/
+#ifndef MDP_MIN_DIVERSITY_H
+#define MDP_MIN_DIVERSITY_H
+
+#include <set>
+#include <vector>
+
+#include "mdp.h"
+
+namespace mdp
+{
+
+class minDiversity
+{
+    private:
+    const Instance &data;
+
+    //Elegidos y pertenencia de cada elemento
+    std::vector<int> members;
+    std::vector<bool> selected;
+
+    //Vecino elegido mas cercano y segundo mas cercano de cada elegido, con sus distancias
+    std::vector<int> nearest, second;
+    std::vector<double> nearestDistance, secondDistance;
+
+    //Recalcula los dos vecinos mas cercanos de s: O(m)
+    void refresh(int s);
+
+    public:
+
+    minDiversity(const Instance &data);
+
+    //Empieza a seguir la solucion sol: O(m*m)
+    void init(const std::set<int> &sol);
+
+    //Menor distancia entre dos elegidos: O(m)
+    double value() const;
+
+    //Menor distancia entre los elegidos si saliera out (sin que entre nadie): O(m)
+    double valueWithout(int out) const;
+
+    //Menor distancia de in a los elegidos salvo out: O(m)
+    double distanceTo(int in, int out) const;
+
+    //Valor si se cambiara out por in, sin aplicarlo: O(m)
+    double swapValue(int out, int in) const;
+
+    //Cambia out por in y actualiza los vecinos mas cercanos. O(m) salvo para los elegidos cuyo
+    //vecino mas cercano o segundo era out, que se recalculan
+    void swap(int out, int in);
+
+    //Elegidos con la menor distancia (extremos de los pares criticos): solo quitando uno de ellos
+    //puede subir el valor
+    std::vector<int> critical() const;
+};
+
+//Menor distancia entre dos elementos de sol, O(m*m). 0 si hay menos de dos
+double minDistance(const Instance &data, const std::set<int> &sol);
+
+}
+
+#endif
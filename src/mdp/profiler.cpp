@@ -0,0 +1,215 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "mdp.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace mdp
+{
+
+namespace
+{
+
+// Contador de hardware y campo de PhaseCounters donde se acumula
+struct counterSpec
+{
+    unsigned int type;
+    unsigned long long config;
+    long long PhaseCounters::*field;
+};
+
+const counterSpec COUNTERS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PhaseCounters::cycles},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PhaseCounters::instructions},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), &PhaseCounters::l1Misses},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &PhaseCounters::llcMisses},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &PhaseCounters::branchMisses},
+};
+const int NUM_COUNTERS = sizeof(COUNTERS) / sizeof(COUNTERS[0]);
+
+const char *PHASE_NAMES[NUM_PHASES] = {"lectura", "construccion", "descenso", "temperatura", "perturbacion"};
+
+long long now()
+{
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+void PhaseCounters::add(const PhaseCounters &other)
+{
+    calls += other.calls;
+    nanoseconds += other.nanoseconds;
+    moves += other.moves;
+
+    for(const counterSpec &c : COUNTERS){
+        if(other.*c.field >= 0){
+            this->*c.field = max(this->*c.field, 0LL) + other.*c.field;
+        }
+    }
+}
+
+Profiler::Profiler():group(-1), owner(0), opened(false), startTime(0), phases(NUM_PHASES)
+{
+}
+
+Profiler::~Profiler()
+{
+    close();
+}
+
+void Profiler::open()
+{
+    close();
+    opened = true;
+    owner = hash<thread::id>()(this_thread::get_id());
+
+    // El primero que se abre es el lider del grupo: todos se leen a la vez con una sola llamada
+    for(int k=0; k < NUM_COUNTERS; k++){
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = COUNTERS[k].type;
+        attr.size = sizeof(attr);
+        attr.config = COUNTERS[k].config;
+        attr.disabled = group < 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+        if(fd < 0){
+            continue;
+        }
+
+        if(group < 0){
+            group = fd;
+        }
+        fds.push_back(fd);
+        fields.push_back(k);
+    }
+
+    if(group >= 0){
+        ioctl(group, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    startValues.assign(fds.size(), 0);
+    values.assign(fds.size(), 0);
+}
+
+void Profiler::close()
+{
+    for(int fd : fds){
+        ::close(fd);
+    }
+
+    fds.clear();
+    fields.clear();
+    group = -1;
+}
+
+bool Profiler::read()
+{
+    // nr, tiempo activo, tiempo contando y un valor por contador
+    vector<unsigned long long> buffer(3 + fds.size());
+    ssize_t bytes = ::read(group, buffer.data(), buffer.size() * sizeof(unsigned long long));
+
+    if(bytes != (ssize_t) (buffer.size() * sizeof(unsigned long long)) || buffer[2] == 0){
+        return false;
+    }
+
+    double scale = (double) buffer[1] / buffer[2];
+    for(size_t k=0; k < fds.size(); k++){
+        values[k] = (long long) (buffer[3 + k] * scale);
+    }
+
+    return true;
+}
+
+void Profiler::begin(Phase)
+{
+    // Los contadores cuentan solo el hilo que los abrio: si la busqueda pasa a otro hilo se reabren
+    if(!opened || owner != hash<thread::id>()(this_thread::get_id())){
+        open();
+    }
+
+    if(group >= 0 && read()){
+        startValues = values;
+    }
+
+    startTime = now();
+}
+
+void Profiler::end(Phase phase, long long moves)
+{
+    long long stop = now();
+
+    PhaseCounters &p = phases[phase];
+    p.calls++;
+    p.nanoseconds += stop - startTime;
+    p.moves += moves;
+
+    if(group >= 0 && read()){
+        for(size_t k=0; k < fds.size(); k++){
+            long long PhaseCounters::*field = COUNTERS[fields[k]].field;
+            p.*field = max(p.*field, 0LL) + values[k] - startValues[k];
+        }
+    }
+}
+
+void writeProfile(ostream &out, const vector<PhaseCounters> &phases)
+{
+    // El formato de out se deja como estaba: detras se sigue escribiendo "valor\ttiempo"
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+
+    bool hardware = false;
+    for(const PhaseCounters &p : phases){
+        hardware = hardware || p.cycles >= 0;
+    }
+
+    // Cociente con dos decimales, o "-" si falta alguno de los dos
+    auto ratio = [&out](long long a, long long b){
+        out << "\t";
+        if(a < 0 || b <= 0){
+            out << "-";
+        }else{
+            out << fixed << setprecision(2) << (double) a / b;
+        }
+    };
+
+    out << "perfil" << (hardware ? "" : " (sin contadores de hardware: solo tiempos)") << endl;
+    out << "fase\tveces\tms\tvecinos\tIPC\tL1/vecino\tLLC/vecino\tsaltos/vecino" << endl;
+
+    for(size_t k=0; k < phases.size() && k < NUM_PHASES; k++){
+        const PhaseCounters &p = phases[k];
+        if(p.calls == 0){
+            continue;
+        }
+
+        out << PHASE_NAMES[k] << "\t" << p.calls << "\t" << fixed << setprecision(3) << p.nanoseconds / 1e6 << "\t" << p.moves;
+        ratio(p.instructions, p.cycles);
+        ratio(p.l1Misses, p.moves);
+        ratio(p.llcMisses, p.moves);
+        ratio(p.branchMisses, p.moves);
+        out << endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
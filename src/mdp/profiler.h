@@ -0,0 +1,44 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Medida de fases dentro de libmdp (uso interno). Profiler esta en mdp.h porque los ejecutables
+    miden con el la lectura del problema.
+*/
+#ifndef MDP_PROFILER_H
+#define MDP_PROFILER_H
+
+#include "mdp.h"
+
+namespace mdp
+{
+
+//Mide una fase mientras existe; los vecinos de la fase son lo que crece counter. Sin profiler
+//(Options::profile a false) no hace nada
+class phaseScope
+{
+    private:
+    Profiler *profiler;
+    Phase phase;
+    const long long &counter;
+    long long before;
+
+    public:
+    phaseScope(Profiler *profiler, Phase phase, const long long &counter):
+        profiler(profiler), phase(phase), counter(counter), before(counter)
+    {
+        if(profiler){
+            profiler->begin(phase);
+        }
+    }
+
+    ~phaseScope()
+    {
+        if(profiler){
+            profiler->end(phase, counter - before);
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <algorithm>
+
+#include "reduction.h"
+#include "maximumDiversityProblem.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+shared_ptr<const Instance> reduceInstance(const Instance &data, const Options &options)
+{
+    const int n = data.getN();
+    const int size = min((long long) n, (long long) options.reduction * data.getM());
+
+    // Veces que cada elemento sale en las construcciones; los de la solucion en caliente van primero
+    vector<int> votes(n, 0);
+    for(int label : options.start){
+        int i = data.getPosition(label);
+        if(i >= 0){
+            votes[i] = REDUCTION_PROBES + 1;
+        }
+    }
+
+    maximumDiversityProblem probe(data, options, seedFor(options.seed, options.firstStart));
+    for(int p=0; p < REDUCTION_PROBES; p++){
+        for(int i : p == 0 ? probe.findGreedySolution() : probe.graspSolution()){
+            votes[i]++;
+        }
+    }
+
+    vector<int> order(n);
+    for(int i=0; i < n; i++){
+        order[i] = i;
+    }
+    partial_sort(order.begin(), order.begin() + size, order.end(), [&](int a, int b){
+        return votes[a] != votes[b] ? votes[a] > votes[b] : data.getRowSum(a) > data.getRowSum(b);
+    });
+
+    // En el orden del problema: si estaba reetiquetado (reorder) el nucleo tambien lo esta
+    vector<int> core(order.begin(), order.begin() + size);
+    sort(core.begin(), core.end());
+
+    return data.subset(core);
+}
+
+}
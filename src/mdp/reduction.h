@@ -0,0 +1,27 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Reduccion del problema (uso interno de libmdp). Con n grande casi ningun elemento llega a las
+    buenas soluciones, asi que las metaheuristicas buscan en un nucleo de k*m candidatos: los que
+    mas veces eligen REDUCTION_PROBES construcciones rapidas (una voraz y el resto GRASP, O(n*m) cada
+    una) y, para completar y desempatar, los de mayor suma de distancias.
+*/
+#ifndef MDP_REDUCTION_H
+#define MDP_REDUCTION_H
+
+#include <memory>
+
+#include "mdp.h"
+
+#define REDUCTION_PROBES 10        // Construcciones para elegir el nucleo
+
+namespace mdp
+{
+
+//Nucleo de options.reduction*m elementos de data, con las etiquetas del fichero. Incluye siempre los
+//elementos de options.start que sigan en el problema
+std::shared_ptr<const Instance> reduceInstance(const Instance &data, const Options &options);
+
+}
+
+#endif
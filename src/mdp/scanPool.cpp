@@ -0,0 +1,77 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include "scanPool.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+scanPool::scanPool(int threads):work(nullptr), generation(0), pending(0), stopping(false)
+{
+    for(int t=1; t < threads; t++){
+        workers.emplace_back(&scanPool::loop, this, t);
+    }
+}
+
+scanPool::~scanPool()
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for(thread &worker : workers){
+        worker.join();
+    }
+}
+
+void scanPool::loop(int id)
+{
+    long long seen = 0;
+
+    while(true){
+        const function<void(int)> *task;
+        {
+            unique_lock<mutex> lock(mtx);
+            wake.wait(lock, [&]{ return stopping || generation != seen; });
+            if(stopping){
+                return;
+            }
+            seen = generation;
+            task = work;
+        }
+
+        (*task)(id);
+
+        lock_guard<mutex> lock(mtx);
+        if(--pending == 0){
+            done.notify_one();
+        }
+    }
+}
+
+void scanPool::run(const function<void(int)> &task)
+{
+    if(workers.empty()){
+        task(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(mtx);
+        work = &task;
+        pending = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    task(0);
+
+    unique_lock<mutex> lock(mtx);
+    done.wait(lock, [&]{ return pending == 0; });
+}
+
+}
@@ -0,0 +1,56 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Hilos fijos para repartir las pasadas de la busqueda local (uso interno de libmdp). Cada llamada
+    a run reparte una tarea por hilo, el que llama hace la primera, y espera a que acaben todas: los
+    hilos se crean una vez por busqueda y entre pasadas duermen en una variable de condicion. Cada
+    pasada es una sola ida y vuelta, asi que solo compensa si probar a sacar un elegido (n-m
+    candidatos de O(m)) cuesta bastante mas que despertar a los hilos.
+*/
+#ifndef MDP_SCAN_POOL_H
+#define MDP_SCAN_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define SCAN_BLOCK 32       // Candidatos a entrar de cada tarea de una pasada
+#define SCAN_MIN_WORK 65536 // (n-m)*m minimo (trabajo de probar a sacar un elegido) para repartir las pasadas
+
+namespace mdp
+{
+
+class scanPool
+{
+    private:
+    std::vector<std::thread> workers;
+
+    std::mutex mtx;
+    std::condition_variable wake, done;
+
+    //Tarea en curso, cuantas llamadas a run van (los hilos esperan a que cambie) y tareas sin acabar
+    const std::function<void(int)> *work;
+    long long generation;
+    int pending;
+    bool stopping;
+
+    void loop(int id);
+
+    public:
+
+    //threads hilos en total, contando el que llama a run
+    scanPool(int threads);
+
+    ~scanPool();
+
+    int size() const { return workers.size() + 1; }
+
+    //Ejecuta task(t) para t en [0, size()) y vuelve cuando han terminado todas
+    void run(const std::function<void(int)> &task);
+};
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Nucleos vectoriales de libmdp (uso interno). Usan SSE2/AVX si el compilador los tiene activados
+    (SSE2 siempre en x86-64, AVX con -mavx o -march=native) y un bucle escalar en otro caso.
+*/
+#ifndef MDP_SIMD_H
+#define MDP_SIMD_H
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace mdp
+{
+
+//Indice del mayor valor de values[0..n) (el primero si hay empates). n > 0
+inline int argmax(const double *values, int n)
+{
+    double best = values[0];
+    int j = 0;
+
+    // Primera pasada: el maximo con varios carriles a la vez
+#if defined(__AVX__)
+    if(n >= 4){
+        __m256d vmax = _mm256_loadu_pd(values);
+        for(j = 4; j + 4 <= n; j += 4){
+            vmax = _mm256_max_pd(vmax, _mm256_loadu_pd(values + j));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, vmax);
+        for(int l = 0; l < 4; l++){
+            if(lanes[l] > best) best = lanes[l];
+        }
+    }
+#elif defined(__SSE2__)
+    if(n >= 2){
+        __m128d vmax = _mm_loadu_pd(values);
+        for(j = 2; j + 2 <= n; j += 2){
+            vmax = _mm_max_pd(vmax, _mm_loadu_pd(values + j));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, vmax);
+        for(int l = 0; l < 2; l++){
+            if(lanes[l] > best) best = lanes[l];
+        }
+    }
+#endif
+    for(; j < n; j++){
+        if(values[j] > best) best = values[j];
+    }
+
+    // Segunda pasada: la primera posicion con ese valor
+    for(j = 0; j < n; j++){
+        if(values[j] == best){
+            break;
+        }
+    }
+
+    return j;
+}
+
+//Suma de values[0..n)
+inline double sum(const double *values, int n)
+{
+    double total = 0;
+    int j = 0;
+
+#if defined(__AVX__)
+    __m256d vsum = _mm256_setzero_pd();
+    for(; j + 4 <= n; j += 4){
+        vsum = _mm256_add_pd(vsum, _mm256_loadu_pd(values + j));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, vsum);
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    __m128d vsum = _mm_setzero_pd();
+    for(; j + 2 <= n; j += 2){
+        vsum = _mm_add_pd(vsum, _mm_loadu_pd(values + j));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, vsum);
+    total = lanes[0] + lanes[1];
+#endif
+    for(; j < n; j++){
+        total += values[j];
+    }
+
+    return total;
+}
+
+}
+
+#endif
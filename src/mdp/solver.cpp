@@ -0,0 +1,272 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include "maximumDiversityProblem.h"
+#include "branchAndBound.h"
+#include "memetic.h"
+#include "trace.h"
+#include "reduction.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace mdp
+{
+
+bool parseAlgorithm(const string &name, Algorithm &algorithm)
+{
+    if(name == "busquedaLocal"){
+        algorithm = LOCAL_SEARCH;
+    }else if(name == "busquedaMultiBasica"){
+        algorithm = MULTI_START;
+    }else if(name == "busquedaLocalReiterada"){
+        algorithm = ITERATED_LOCAL_SEARCH;
+    }else if(name == "busquedaLocalReiterada-ES"){
+        algorithm = ITERATED_SIM_ANNEALING;
+    }else if(name == "enfriamientoSimulado"){
+        algorithm = SIM_ANNEALING;
+    }else if(name == "greedy"){
+        algorithm = GREEDY;
+    }else if(name == "exhaustiva"){
+        algorithm = EXHAUSTIVE;
+    }else if(name == "exacta"){
+        algorithm = BRANCH_AND_BOUND;
+    }else if(name == "algoritmoMemetico"){
+        algorithm = MEMETIC;
+    }else if(name == "busquedaVecindarioVariable"){
+        algorithm = VARIABLE_NEIGHBORHOOD;
+    }else{
+        return false;
+    }
+
+    return true;
+}
+
+vector<string> parseArguments(int argc, char const *argv[], Options &options)
+{
+    vector<string> args;
+
+    for(int i=0; i < argc; i++){
+        string arg = argv[i];
+
+        if(arg == "--maxmin"){
+            options.objective = MAX_MIN;
+        }else if(arg == "--perfil"){
+            options.profile = true;
+        }else if(arg == "--memoria"){
+            options.memory = true;
+        }else if(arg == "--reenlazar"){
+            options.relinking = true;
+        }else if(arg.compare(0, 8, "--traza=") == 0){
+#ifdef MDP_TRACE
+            options.trace = arg.substr(8);
+#else
+            // Sin MDP_TRACE no se escribiria nada: mejor avisar que dejar esperando el fichero
+            cerr << "Aviso: libmdp se ha compilado sin trazas (make clean; make TRACE=1), se ignora " << arg << endl;
+#endif
+        }else if(arg.compare(0, 9, "--nucleo=") == 0){
+            options.reduction = stoi(arg.substr(9));
+        }else if(arg.compare(0, 10, "--barrido=") == 0){
+            options.scanThreads = stoi(arg.substr(10));
+        }else{
+            args.push_back(arg);
+        }
+    }
+
+    return args;
+}
+
+Solver::Solver(shared_ptr<const Instance> instance, const Options &options):instance(instance), options(options)
+{
+}
+
+Result Solver::solve() const
+{
+    Result result;
+
+    if(!instance){
+        return result;
+    }
+
+    bool reducible = options.algorithm != EXHAUSTIVE && options.algorithm != BRANCH_AND_BOUND && options.algorithm != GREEDY;
+    if(options.reduction > 0 && reducible && (long long) options.reduction * instance->getM() < instance->getN()){
+        return solveReduced();
+    }
+
+    // La ramificacion y poda reparte ella misma los subarboles entre los hilos
+    if(options.algorithm == BRANCH_AND_BOUND && options.objective == MAX_SUM){
+        return branchAndBound(*instance, options).solve();
+    }
+
+    // El memetico tiene su propia poblacion y reparte los hijos entre los hilos
+    if(options.algorithm == MEMETIC){
+        return memeticSearch(*instance, options).solve();
+    }
+
+    const int threads = options.threads > 1 ? options.threads : 1;
+
+    // Cronometramos el tiempo en us
+    auto start = high_resolution_clock::now();
+
+#ifdef MDP_TRACE
+    // Se destruye despues de las busquedas y vuelca lo que quede al salir
+    unique_ptr<traceWriter> writer;
+    if(!options.trace.empty()){
+        writer.reset(new traceWriter(options.trace));
+    }
+#endif
+
+    // Un estado de busqueda por hilo; el problema es compartido
+    vector<unique_ptr<maximumDiversityProblem>> searches;
+    for(int w=0; w < threads; w++){
+        searches.emplace_back(new maximumDiversityProblem(*instance, options, seedFor(options.seed, options.firstStart + w)));
+        searches[w]->setScanThreads(options.scanThreads);
+#ifdef MDP_TRACE
+        if(writer && writer->isOpen()){
+            searches[w]->setTrace(writer->ring());
+        }
+#endif
+    }
+
+    auto run = [this, threads, &searches](int w){
+        maximumDiversityProblem &gd = *searches[w];
+
+        switch(options.algorithm){
+            case LOCAL_SEARCH:           gd.findRandomLocalSearchSolution(); break;
+            case MULTI_START:            gd.findMultiStartSolution(w, threads); break;
+            case ITERATED_LOCAL_SEARCH:  gd.findIteratedLocalSearch(); break;
+            case ITERATED_SIM_ANNEALING: gd.findIteratedSimAnnealing(); break;
+            case SIM_ANNEALING:          gd.findRandomSimAnnealingSolution(); break;
+            case GREEDY:                 gd.findGreedySolution(); break;
+            case EXHAUSTIVE:             gd.findExhaustiveSolution(w, threads); break;
+            case BRANCH_AND_BOUND:       gd.findExhaustiveSolution(w, threads); break;
+            case MEMETIC:                break;
+            case VARIABLE_NEIGHBORHOOD:  gd.findVariableNeighborhoodSearch(); break;
+        }
+    };
+
+    auto parallel = [threads](const function<void(int)> &work){
+        if(threads == 1){
+            work(0);
+        }else{
+            vector<thread> workers;
+            for(int w=0; w < threads; w++){
+                workers.emplace_back(work, w);
+            }
+            for(thread &worker : workers){
+                worker.join();
+            }
+        }
+    };
+
+    parallel(run);
+
+    // Reenlazado de caminos: se juntan los elite de todos los hilos (en orden de hilo) y los pares se
+    // reparten entre los hilos. Cada par va del mejor al peor de los dos
+    bool relinkable = options.algorithm == MULTI_START || options.algorithm == ITERATED_LOCAL_SEARCH || options.algorithm == ITERATED_SIM_ANNEALING;
+    if(options.relinking && relinkable){
+        elitePool pool;
+        for(int w=0; w < threads; w++){
+            for(const eliteSolution &e : searches[w]->getElite().solutions()){
+                pool.offer(e.solution, e.value, e.hash);
+            }
+        }
+
+        vector<eliteSolution> elite = pool.solutions();
+        stable_sort(elite.begin(), elite.end(), [](const eliteSolution &a, const eliteSolution &b){ return a.value > b.value; });
+
+        vector<pair<int,int>> pairs;
+        for(size_t a=0; a < elite.size(); a++){
+            for(size_t b=a+1; b < elite.size(); b++){
+                pairs.push_back({a, b});
+            }
+        }
+
+        parallel([&](int w){
+            for(size_t k = w; k < pairs.size(); k += threads){
+                searches[w]->relinkPath(elite[pairs[k].first].solution, elite[pairs[k].second].solution);
+            }
+        });
+    }
+
+    // Nos quedamos con la mejor (ante empate, la del hilo de menor indice). La exhaustiva reparte los
+    // subconjuntos entre los hilos: ante empate, la menor en orden lexicografico, como con un hilo
+    bool exhaustive = options.algorithm == EXHAUSTIVE || options.algorithm == BRANCH_AND_BOUND;
+    int best = 0;
+    for(int w=0; w < threads; w++){
+        double value = searches[w]->getBestValue(), bestValue = searches[best]->getBestValue();
+        if(value > bestValue || (exhaustive && value == bestValue && searches[w]->getBestSolution() < searches[best]->getBestSolution())){
+            best = w;
+        }
+
+        result.evaluations += searches[w]->getEvaluations();
+        result.skipped += searches[w]->getSkipped();
+        result.cacheLookups += searches[w]->getCacheLookups();
+        result.cacheHits += searches[w]->getCacheHits();
+    }
+
+    if(options.profile){
+        result.phases.resize(NUM_PHASES);
+        for(int w=0; w < threads; w++){
+            for(int k=0; k < NUM_PHASES; k++){
+                result.phases[k].add(searches[w]->getProfiler()->getPhases()[k]);
+            }
+        }
+    }
+
+    auto stop = high_resolution_clock::now();
+    result.microseconds = duration_cast<microseconds>(stop - start).count();
+
+    // Devolvemos la solucion con las etiquetas del fichero
+    for(int i : searches[best]->getBestSolution()){
+        result.solution.push_back(instance->getLabel(i));
+    }
+    sort(result.solution.begin(), result.solution.end());
+    result.value = searches[best]->evaluation();
+    result.bound = options.objective == MAX_SUM ? instance->getUpperBound() : 0;
+
+    return result;
+}
+
+Result Solver::solveReduced() const
+{
+    auto start = high_resolution_clock::now();
+
+    Options coreOptions = options;
+    coreOptions.reduction = 0;
+    Result result = Solver(reduceInstance(*instance, options), coreOptions).solve();
+
+    // Pulido: busqueda local sobre el problema completo desde la solucion del nucleo, con diez pasadas
+    // completas de presupuesto (o el de las busquedas, si es mayor)
+    const long long passes = 10LL * (instance->getN() - instance->getM()) * instance->getM();
+    Options polish = coreOptions;
+    polish.algorithm = LOCAL_SEARCH;
+    polish.threads = 1;
+    polish.budget = min<long long>(max<long long>(options.budget, passes), numeric_limits<int>::max() / 2);
+    polish.start = result.solution;
+    polish.changed.clear();
+    // La traza es la de la busqueda en el nucleo: otro traceWriter en el mismo fichero la vaciaria
+    polish.trace.clear();
+    Result polished = Solver(instance, polish).solve();
+
+    polished.evaluations += result.evaluations;
+    polished.skipped += result.skipped;
+    polished.cacheLookups += result.cacheLookups;
+    polished.cacheHits += result.cacheHits;
+    for(size_t k=0; k < result.phases.size() && k < polished.phases.size(); k++){
+        polished.phases[k].add(result.phases[k]);
+    }
+    polished.microseconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    return polished;
+}
+
+}
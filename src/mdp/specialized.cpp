@@ -0,0 +1,28 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include "specialized.h"
+
+namespace mdp
+{
+
+template<int M>
+static const mKernels &instance()
+{
+    static const mKernels kernels = {&fixedKernels<M>::contribution, &fixedKernels<M>::evaluate};
+    return kernels;
+}
+
+const mKernels &kernelsFor(int m)
+{
+    switch(m){
+        case 4:   return instance<4>();
+        case 10:  return instance<10>();
+        case 25:  return instance<25>();
+        case 50:  return instance<50>();
+        case 100: return instance<100>();
+        default:  return instance<0>();
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Nucleos especializados en m (uso interno de libmdp). m se conoce al cargar el problema y casi
+    siempre es uno de unos pocos tamanios, asi que cada nucleo es una plantilla en M: con M fijo el
+    bucle tiene un numero de vueltas conocido, el compilador lo desenrolla y los acumuladores se
+    quedan en registros. kernelsFor elige en tiempo de ejecucion la instancia de 4, 10, 25, 50 o 100
+    elementos y, para cualquier otro m, la generica (M = 0).
+*/
+#ifndef MDP_SPECIALIZED_H
+#define MDP_SPECIALIZED_H
+
+#include <array>
+
+#include "mdp.h"
+
+namespace mdp
+{
+
+template<int M>
+struct fixedKernels
+{
+    //Suma de row[members[0..count)] con cuatro acumuladores
+    static double gather(const double *row, const int *members, int count)
+    {
+        double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        int k = 0;
+
+        for(; k + 4 <= count; k += 4){
+            a0 += row[members[k]];
+            a1 += row[members[k+1]];
+            a2 += row[members[k+2]];
+            a3 += row[members[k+3]];
+        }
+        for(; k < count; k++){
+            a0 += row[members[k]];
+        }
+
+        return (a0 + a1) + (a2 + a3);
+    }
+
+    //Contribucion de la fila row a los m elegidos
+    static double contribution(const double *row, const int *members, int m)
+    {
+        if constexpr (M > 0){
+            return gather(row, members, M);
+        }else{
+            return gather(row, members, m);
+        }
+    }
+
+    //MaxSum de los m elegidos: cada fila con los elegidos que van detras
+    static double evaluate(const Instance &data, const int *members, int m)
+    {
+        if constexpr (M > 0){
+            std::array<int, M> chosen;
+            for(int k=0; k < M; k++){
+                chosen[k] = members[k];
+            }
+
+            double value = 0;
+            for(int a=0; a < M - 1; a++){
+                value += gather(data.getRow(chosen[a]), chosen.data() + a + 1, M - 1 - a);
+            }
+            return value;
+        }else{
+            double value = 0;
+            for(int a=0; a < m - 1; a++){
+                value += gather(data.getRow(members[a]), members + a + 1, m - 1 - a);
+            }
+            return value;
+        }
+    }
+};
+
+//Nucleos para un m concreto
+struct mKernels
+{
+    double (*contribution)(const double *row, const int *members, int m);
+    double (*evaluate)(const Instance &data, const int *members, int m);
+};
+
+//Instancia para m (la generica si m no es uno de los tamanios especializados)
+const mKernels &kernelsFor(int m);
+
+}
+
+#endif
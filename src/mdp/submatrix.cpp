@@ -0,0 +1,84 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include "submatrix.h"
+#include "simd.h"
+
+using namespace std;
+
+namespace mdp
+{
+
+submatrix::submatrix(const Instance &data):data(data), kernels(kernelsFor(data.getM()))
+{
+    slot.assign(data.getN(), -1);
+}
+
+void submatrix::init(const set<int> &sol)
+{
+    for(int s : members){
+        slot[s] = -1;
+    }
+
+    members.assign(sol.begin(), sol.end());
+    int m = members.size();
+
+    matrix.assign((size_t) m * m, 0.0);
+    sums.assign(m, 0.0);
+
+    for(int a=0; a < m; a++){
+        slot[members[a]] = a;
+
+        const double *row = data.getRow(members[a]);
+        double *out = matrix.data() + (size_t) a * m;
+        for(int b=0; b < m; b++){
+            out[b] = row[members[b]];
+        }
+        sums[a] = sum(out, m);
+    }
+}
+
+double submatrix::value() const
+{
+    return sum(matrix.data(), matrix.size()) / 2;
+}
+
+double submatrix::contributionOf(int j) const
+{
+    return kernels.contribution(data.getRow(j), members.data(), members.size());
+}
+
+double submatrix::swapValue(double value, int out, int in) const
+{
+    return value - contribution(out) + contributionOf(in) - data.getDistance(in, out);
+}
+
+void submatrix::swap(int out, int in)
+{
+    if(out == in){
+        return;
+    }
+
+    int m = members.size();
+    int s = slot[out];
+
+    members[s] = in;
+    slot[out] = -1;
+    slot[in] = s;
+
+    // Nueva fila s y, por simetria, nueva columna s; las sumas de las demas filas cambian en una casilla
+    const double *row = data.getRow(in);
+    double *rowS = matrix.data() + (size_t) s * m;
+    for(int k=0; k < m; k++){
+        double d = k == s ? 0.0 : row[members[k]];
+        if(k != s){
+            double *cell = matrix.data() + (size_t) k * m + s;
+            sums[k] += d - *cell;
+            *cell = d;
+        }
+        rowS[k] = d;
+    }
+    sums[s] = sum(rowS, m);
+}
+
+}
@@ -0,0 +1,65 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Submatriz de distancias de la solucion actual (uso interno de libmdp): los m elegidos en un
+    vector, sus distancias en una matriz m*m contigua y la contribucion de cada uno. Un intercambio
+    reemplaza una fila y una columna en O(m), y el valor es una suma contigua de m*m posiciones en
+    lugar de recorrer la matriz n*n saltando con iteradores de set.
+*/
+#ifndef MDP_SUBMATRIX_H
+#define MDP_SUBMATRIX_H
+
+#include <set>
+#include <vector>
+
+#include "mdp.h"
+#include "specialized.h"
+
+namespace mdp
+{
+
+class submatrix
+{
+    private:
+    const Instance &data;
+
+    //Nucleos para el m del problema
+    const mKernels &kernels;
+
+    //Elegidos y casilla de cada elemento en la submatriz (-1 si no esta elegido)
+    std::vector<int> members;
+    std::vector<int> slot;
+
+    //Distancias entre los elegidos (m*m por filas) y suma de cada fila
+    std::vector<double> matrix;
+    std::vector<double> sums;
+
+    public:
+
+    submatrix(const Instance &data);
+
+    //Copia las distancias de los elementos de sol: O(m*m)
+    void init(const std::set<int> &sol);
+
+    //MaxSum de los elegidos: suma de la matriz entre dos
+    double value() const;
+
+    //Contribucion del elegido i a los demas: O(1)
+    double contribution(int i) const { return sums[slot[i]]; }
+
+    //Contribucion de j (no elegido) a los elegidos: O(m) sobre un vector contiguo
+    double contributionOf(int j) const;
+
+    //Valor si se cambiara out (elegido) por in, partiendo de value: O(m)
+    double swapValue(double value, int out, int in) const;
+
+    //Cambia out por in reemplazando su fila y su columna: O(m)
+    void swap(int out, int in);
+
+    //Elegidos en el orden de la submatriz
+    const std::vector<int> &getMembers() const { return members; }
+};
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+*/
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "trace.h"
+#include "mdp.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace mdp
+{
+
+static const char *eventNames[TRACE_EVENTS] = {
+    "intercambio", "acepta", "rechaza", "temperatura", "mejor", "inicio_bl", "fin_bl", "perturbacion"
+};
+
+long long traceTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+traceRing::traceRing(int thread):records(new traceRecord[TRACE_RING_SIZE]), head(0), tail(0), thread(thread), last(traceTicks()), dropped(0)
+{
+}
+
+void traceRing::drain(ofstream &out)
+{
+    unsigned long long t = tail.load(memory_order_relaxed);
+    unsigned long long h = head.load(memory_order_acquire);
+
+    // Los pendientes pueden dar la vuelta al final del anillo: como mucho dos trozos contiguos
+    while(t != h){
+        size_t first = t & (TRACE_RING_SIZE - 1);
+        size_t count = min<unsigned long long>(h - t, TRACE_RING_SIZE - first);
+        out.write((const char *) &records[first], count * sizeof(traceRecord));
+        t += count;
+    }
+
+    tail.store(t, memory_order_release);
+}
+
+traceWriter::traceWriter(const string &path):file(path, ios::binary), startTime(steady_clock::now()), stop(false)
+{
+    memcpy(header.magic, "MDPT", 4);
+    header.recordSize = sizeof(traceRecord);
+    header.ticksPerMicrosecond = 0;
+    header.start = traceTicks();
+    header.dropped = 0;
+
+    if(!file.is_open()){
+        return;
+    }
+
+    // La cabecera se completa al cerrar, cuando se sabe cuantos ciclos hay por us
+    file.write((const char *) &header, sizeof(header));
+
+    flusher = thread([this](){
+        while(!stop.load()){
+            this_thread::sleep_for(milliseconds(TRACE_FLUSH_MS));
+            drainAll();
+        }
+    });
+}
+
+traceWriter::~traceWriter()
+{
+    if(!file.is_open()){
+        return;
+    }
+
+    stop = true;
+    flusher.join();
+    drainAll();
+
+    double us = duration_cast<nanoseconds>(steady_clock::now() - startTime).count() / 1e3;
+    header.ticksPerMicrosecond = us > 0 ? (traceTicks() - header.start) / us : 1;
+    for(const unique_ptr<traceRing> &r : rings){
+        header.dropped += r->dropped.load();
+    }
+
+    file.seekp(0);
+    file.write((const char *) &header, sizeof(header));
+}
+
+void traceWriter::drainAll()
+{
+    lock_guard<mutex> lock(mtx);
+
+    for(const unique_ptr<traceRing> &r : rings){
+        r->drain(file);
+    }
+}
+
+traceRing *traceWriter::ring()
+{
+    lock_guard<mutex> lock(mtx);
+
+    rings.emplace_back(new traceRing(rings.size()));
+    return rings.back().get();
+}
+
+long long exportTrace(const string &path, ostream &csv)
+{
+    ifstream in(path, ios::binary);
+    traceHeader header;
+
+    if(!in.read((char *) &header, sizeof(header)) || memcmp(header.magic, "MDPT", 4) != 0 || header.recordSize != sizeof(traceRecord)){
+        return -1;
+    }
+
+    double ticks = header.ticksPerMicrosecond > 0 ? header.ticksPerMicrosecond : 1;
+
+    csv << "hilo,tiempo_us,evento,a,b,valor,extra\n";
+
+    traceRecord r;
+    while(in.read((char *) &r, sizeof(r))){
+        const char *name = r.type < TRACE_EVENTS ? eventNames[r.type] : "?";
+        csv << r.thread << "," << (r.time - header.start) / ticks << "," << name << "," << r.a << "," << r.b << "," << r.value << "," << r.extra << "\n";
+    }
+
+    return header.dropped;
+}
+
+}
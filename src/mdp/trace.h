@@ -0,0 +1,146 @@
+/*  Autor: Juan Miguel Gomez
+    Fecha: 19/10/2026
+
+    Trazas binarias de las busquedas (uso interno de libmdp). Solo existen si libmdp se compila con
+    MDP_TRACE (make TRACE=1); sin ella MDP_TRACE_EVENT no genera codigo.
+
+    Cada hilo escribe registros de tamanio fijo en su propio anillo sin cerrojos (un productor, el
+    hilo de la busqueda, y un consumidor, el hilo que vuelca al fichero). Si el anillo esta lleno el
+    registro se descarta y se cuenta, para no frenar nunca la busqueda. El tiempo es el contador de
+    ciclos del procesador (rdtsc en x86-64) y la cabecera del fichero guarda cuantos hay por us.
+*/
+#ifndef MDP_TRACE_H
+#define MDP_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TRACE_RING_SIZE (1 << 14)   // Registros de cada anillo (potencia de 2): caben en la cache
+#define TRACE_FLUSH_MS 1            // Milisegundos entre dos vuelcos
+
+#ifdef MDP_TRACE
+#define MDP_TRACE_EVENT(ring, type, a, b, value, extra) do{ if(ring) (ring)->push(type, a, b, value, extra); }while(0)
+#else
+#define MDP_TRACE_EVENT(ring, type, a, b, value, extra) do{}while(0)
+#endif
+
+namespace mdp
+{
+
+//Tipos de registro: a y b son los elementos que salen y entran (o contadores), value el valor de la
+//solucion y extra lo que depende del tipo
+enum traceEvent
+{
+    TRACE_MOVE = 0,             // Intercambio aplicado en busqueda local: extra = mejora
+    TRACE_ACCEPT,               // Vecino aceptado en el enfriamiento: extra = empeoramiento
+    TRACE_REJECT,               // Vecino rechazado en el enfriamiento: extra = empeoramiento
+    TRACE_TEMPERATURE,          // Fin de nivel de temperatura: a = vecinos, b = aceptados, extra = temperatura
+    TRACE_BEST,                 // Nueva mejor solucion
+    TRACE_DESCENT_START,        // Empieza una busqueda local
+    TRACE_DESCENT_END,          // Termina una busqueda local: a = intercambios evaluados
+    TRACE_PERTURB,              // Perturbacion de la reiterada: a = elementos cambiados
+    TRACE_EVENTS
+};
+
+//32 bytes: dos registros por linea de cache
+struct traceRecord
+{
+    long long time;
+    double value;
+    float extra;
+    int a, b;
+    unsigned short type;
+    unsigned short thread;
+};
+
+struct traceHeader
+{
+    char magic[4];
+    unsigned int recordSize;
+    double ticksPerMicrosecond;
+    long long start;
+    long long dropped;
+};
+
+//Ciclos (o ns si no hay contador de ciclos)
+long long traceTicks();
+
+class traceRing
+{
+    private:
+    //Sin inicializar: las paginas solo se tocan al llegar a ellas
+    std::unique_ptr<traceRecord[]> records;
+
+    //head lo avanza el productor y tail el consumidor
+    std::atomic<unsigned long long> head, tail;
+
+    unsigned short thread;
+
+    //Hora del ultimo registro (solo la usa el productor)
+    long long last;
+
+    public:
+    //Registros descartados por anillo lleno (solo lo escribe el productor)
+    std::atomic<long long> dropped;
+
+    traceRing(int thread);
+
+    void push(int type, int a, int b, double value, double extra)
+    {
+        unsigned long long h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == TRACE_RING_SIZE){
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Los rechazos del enfriamiento son casi todos los registros: llevan la hora del anterior
+        if(type != TRACE_REJECT){
+            last = traceTicks();
+        }
+
+        records[h & (TRACE_RING_SIZE - 1)] = {last, value, (float) extra, a, b, (unsigned short) type, thread};
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    //Escribe en out los registros pendientes (solo desde el consumidor)
+    void drain(std::ofstream &out);
+};
+
+//Fichero de traza: un anillo por hilo y un hilo que los vuelca cada TRACE_FLUSH_MS
+class traceWriter
+{
+    private:
+    std::ofstream file;
+    traceHeader header;
+    std::chrono::steady_clock::time_point startTime;
+
+    std::vector<std::unique_ptr<traceRing>> rings;
+    std::mutex mtx;
+
+    std::atomic<bool> stop;
+    std::thread flusher;
+
+    void drainAll();
+
+    public:
+
+    traceWriter(const std::string &path);
+
+    //Vuelca lo que quede y completa la cabecera
+    ~traceWriter();
+
+    bool isOpen() const { return file.is_open(); }
+
+    //Anillo nuevo para un hilo (vive tanto como el traceWriter)
+    traceRing *ring();
+};
+
+}
+
+#endif
@@ -0,0 +1,489 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make pruebasMDP
+    Ejecutar: ./pruebasMDP              (o make test)
+    Fecha: 19/10/2026
+
+    Pruebas de libmdp sobre problemas pequenios construidos en memoria. Escribe una linea por prueba
+    y termina con 1 si alguna falla.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "mdp/mdp.h"
+#include "mdp/maximumDiversityProblem.h"
+
+using namespace std;
+using namespace mdp;
+
+int failures = 0;
+
+void check(bool ok, const string &name)
+{
+    cout << (ok ? "OK     " : "FALLO  ") << name << endl;
+    failures += !ok;
+}
+
+// n elementos a distancia 1 salvo los pares dados, a distancia 0
+shared_ptr<const Instance> plateau(int n, int m, const vector<pair<int,int>> &zeros)
+{
+    vector<double> distances((size_t) n * n, 1.0);
+    for(int i=0; i < n; i++){
+        distances[(size_t) i * n + i] = 0;
+    }
+    for(const pair<int,int> &z : zeros){
+        distances[(size_t) z.first * n + z.second] = 0;
+        distances[(size_t) z.second * n + z.first] = 0;
+    }
+
+    return make_shared<const Instance>(n, m, distances);
+}
+
+// Max-Min: con dos elegidos a distancia 0 el coste de partida es 0 y la temperatura inicial no puede
+// salir de el. El enfriamiento tiene que moverse y salir de la solucion de valor 0
+void annealingMaxMinFromZero()
+{
+    shared_ptr<const Instance> data = plateau(40, 10, {{0, 1}, {2, 3}, {4, 5}});
+
+    Options options;
+    options.objective = MAX_MIN;
+    options.seed = 7;
+    options.start = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    for(Algorithm algorithm : {SIM_ANNEALING, ITERATED_SIM_ANNEALING}){
+        options.algorithm = algorithm;
+        Result result = Solver(data, options).solve();
+
+        string name = algorithm == SIM_ANNEALING ? "enfriamiento" : "reiterada con enfriamiento";
+        check(result.evaluations > 0 && result.value == 1.0, name + " Max-Min desde valor 0");
+    }
+}
+
+// Con n == m no hay con quien intercambiar: el vecindario variable no puede agitar la solucion (antes
+// se quedaba buscando un elemento fuera de ella para siempre)
+void variableNeighborhoodWithoutOutsiders()
+{
+    shared_ptr<const Instance> data = plateau(6, 6, {});
+
+    Options options;
+    options.algorithm = VARIABLE_NEIGHBORHOOD;
+    Result result = Solver(data, options).solve();
+
+    check(result.value == 15.0 && result.solution.size() == 6, "vecindario variable con n == m");
+}
+
+// La exhaustiva con varios hilos se reparte los subconjuntos: mismo resultado que con uno y, en MaxSum,
+// los C(n,m) subconjuntos evaluados una sola vez en total (antes cada hilo los recorria todos)
+void exhaustiveSplitAcrossThreads()
+{
+    shared_ptr<const Instance> data = Instance::generate(18, 5, UNIFORM_DISTANCES, 3);
+
+    for(Objective objective : {MAX_SUM, MAX_MIN}){
+        Options options;
+        options.algorithm = objective == MAX_SUM ? EXHAUSTIVE : BRANCH_AND_BOUND;
+        options.objective = objective;
+
+        Result single = Solver(data, options).solve();
+        options.threads = 3;
+        Result split = Solver(data, options).solve();
+
+        string name = objective == MAX_SUM ? "exhaustiva" : "exacta Max-Min";
+        check(split.value == single.value && split.solution == single.solution, name + " con 3 hilos: misma solucion");
+        // Con Max-Min cada hilo poda con su propia mejor, asi que solo se compara la solucion
+        if(objective == MAX_SUM){
+            check(split.evaluations == single.evaluations, name + " con 3 hilos: sin repetir subconjuntos");
+        }
+    }
+}
+
+// Cache de optimos locales: con 8 elementos y m = 4 solo hay 70 soluciones, asi que en 40 arranques
+// se repiten soluciones de partida (y optimos) y bajan desde la cache. Cada arranque se repite con
+// firstStart en su propio Solver, sin cache: la multiarranque tiene que dar la misma solucion que el
+// mejor de ellos y ahorrarse las evaluaciones de los aciertos
+void cacheHitMatchesFreshDescent()
+{
+    shared_ptr<const Instance> data = Instance::generate(8, 4, UNIFORM_DISTANCES, 5);
+
+    Options options;
+    options.algorithm = MULTI_START;
+    options.starts = 40;
+    options.seed = 11;
+
+    Result cached = Solver(data, options).solve();
+
+    Result best;
+    long long evaluations = 0;
+    options.starts = 1;
+    for(int k=0; k < 40; k++){
+        options.firstStart = k;
+        Result fresh = Solver(data, options).solve();
+        evaluations += fresh.evaluations;
+        if(fresh.value > best.value){
+            best = fresh;
+        }
+    }
+
+    check(cached.cacheHits > 0, "cache: los arranques repetidos aciertan");
+    check(cached.value == best.value && cached.solution == best.solution, "cache: mismo optimo que sin cache");
+    check(cached.evaluations < evaluations, "cache: los aciertos no evaluan vecinos");
+}
+
+// La misma solucion de partida bajada dos veces con cache: la segunda acierta y devuelve lo mismo
+// que una busqueda local nueva (en otro objeto, sin cache) desde esa solucion
+void cachedDescentTwice()
+{
+    shared_ptr<const Instance> data = Instance::generate(80, 8, UNIFORM_DISTANCES, 9);
+    Options options;
+
+    maximumDiversityProblem cached(*data, options, 1), fresh(*data, options, 1);
+    set<int> start = cached.randomSolution();
+    vector<set<int>> optima;
+    vector<double> values;
+
+    for(int k=0; k < 2; k++){
+        set<int> solution = start;
+        double value = 0;
+        unsigned long long hash = cached.hashSolution(solution);
+        cached.findCachedLocalSearchSolution(solution, value, hash, 1000000);
+        optima.push_back(solution);
+        values.push_back(value);
+    }
+
+    set<int> solution = start;
+    double value = 0;
+    unsigned long long hash = fresh.hashSolution(solution);
+    fresh.findLocalSearchSolution(solution, value, hash, 1000000);
+
+    check(cached.getCacheHits() == 1, "cache: la segunda bajada acierta");
+    check(optima[0] == solution && optima[1] == solution && values[1] == value, "cache: el acierto es la busqueda nueva");
+}
+
+// writeProfile no puede cambiar el formato del flujo en el que escribe
+void profileKeepsStreamFormat()
+{
+    vector<PhaseCounters> phases(NUM_PHASES);
+    phases[DESCENT_PHASE].calls = 1;
+    phases[DESCENT_PHASE].moves = 3;
+    phases[DESCENT_PHASE].cycles = 7;
+    phases[DESCENT_PHASE].instructions = 5;
+
+    ostringstream out;
+    out << 7794.3456 << " ";
+    writeProfile(out, phases);
+    out << 7794.3456;
+
+    string text = out.str();
+    check(text.substr(0, 8) == "7794.35 " && text.substr(text.size() - 7) == "7794.35", "perfil: respeta el formato del flujo");
+}
+
+// Busqueda local con la pasada repartida entre hilos: con (n-m)*m = 450*150 por encima de
+// SCAN_MIN_WORK se crean los hilos y cada paso tiene que elegir el mismo intercambio que en serie, asi
+// que la solucion y las evaluaciones (tambien al cortar por presupuesto) son las mismas
+void parallelScanMatchesSerial()
+{
+    shared_ptr<const Instance> data = Instance::generate(600, 150, UNIFORM_DISTANCES, 11);
+
+    for(Algorithm algorithm : {MULTI_START, ITERATED_LOCAL_SEARCH}){
+        Options options;
+        options.algorithm = algorithm;
+        options.starts = 3;
+
+        Result serial = Solver(data, options).solve();
+        options.scanThreads = 3;
+        Result split = Solver(data, options).solve();
+
+        string name = algorithm == MULTI_START ? "multiarranque" : "reiterada";
+        check(split.value == serial.value && split.solution == serial.solution && split.evaluations == serial.evaluations,
+              name + " con la pasada en 3 hilos: mismo resultado");
+    }
+}
+
+// Distancias con un decimal: hay muchos empates y, por redondeo, dos empatados dan delta > 0
+shared_ptr<const Instance> oneDecimal(int n, int m, unsigned int seed)
+{
+    shared_ptr<Instance> data = Instance::generate(n, m, UNIFORM_DISTANCES, seed);
+
+    vector<double> distances((size_t) n * n, 0.0);
+    for(int i=0; i < n; i++){
+        for(int j=0; j < n; j++){
+            distances[(size_t) i * n + j] = i == j ? 0 : round(data->getDistance(i, j) * 10) / 10;
+        }
+    }
+
+    return make_shared<const Instance>(n, m, distances);
+}
+
+// Reduccion con un nucleo pequenio: la busqueda local final sobre el problema completo tiene que
+// terminar (antes no tenia limite y se cambiaba entre dos empatados para siempre). Si en 30 s no ha
+// terminado se da por fallida y se sale, porque el hilo no se puede parar
+void reductionFinishes()
+{
+    shared_ptr<const Instance> data = oneDecimal(200, 20, 1);
+
+    for(string algorithm : {"busquedaMultiBasica", "busquedaLocalReiterada", "busquedaLocalReiterada-ES", "enfriamientoSimulado",
+                            "algoritmoMemetico", "busquedaVecindarioVariable"}){
+        for(int reduction : {2, 3}){
+            Options options;
+            parseAlgorithm(algorithm, options.algorithm);
+            options.reduction = reduction;
+            options.seed = 1;
+
+            string name = algorithm + " con nucleo " + to_string(reduction) + "*m";
+            future<Result> run = async(launch::async, [&]{ return Solver(data, options).solve(); });
+            if(run.wait_for(chrono::seconds(30)) != future_status::ready){
+                check(false, name + ": termina");
+                cout.flush();
+                _exit(1);
+            }
+
+            Result result = run.get();
+            check(result.solution.size() == 20 && result.value > 0, name + ": termina");
+        }
+    }
+}
+
+// Reiterada: con n = 14 y m = 10 cada perturbacion cambia un elemento de la mejor solucion, asi que
+// se repiten soluciones de partida. Con menos presupuesto que una pasada (como la reiterada por
+// defecto con n grande) ninguna bajada llega a un optimo local; antes heredaban ademas los umbrales
+// de la anterior y no se guardaba ninguna
+void iteratedSearchHitsCache()
+{
+    shared_ptr<const Instance> data = Instance::generate(14, 10, UNIFORM_DISTANCES, 4);
+
+    Options options;
+    options.algorithm = ITERATED_LOCAL_SEARCH;
+    options.starts = 40;
+    options.budget = 20;
+    options.seed = 2;
+    Result result = Solver(data, options).solve();
+
+    check(result.cacheHits > 0, "cache: la reiterada repite perturbaciones y acierta");
+}
+
+// Una bajada cortada por maxIter tambien se guarda: con los bits de no mirar recien activados es
+// determinista, asi que el acierto tiene que ser lo que deja otra bajada con el mismo maxIter
+void cachedTruncatedDescent()
+{
+    shared_ptr<const Instance> data = Instance::generate(80, 8, UNIFORM_DISTANCES, 9);
+    Options options;
+
+    maximumDiversityProblem cached(*data, options, 1), fresh(*data, options, 1);
+    set<int> start = cached.randomSolution();
+    vector<set<int>> reached;
+
+    for(int k=0; k < 2; k++){
+        set<int> solution = start;
+        double value = 0;
+        unsigned long long hash = cached.hashSolution(solution);
+        cached.findCachedLocalSearchSolution(solution, value, hash, 100);
+        reached.push_back(solution);
+    }
+
+    set<int> solution = start;
+    double value = 0;
+    unsigned long long hash = fresh.hashSolution(solution);
+    fresh.findLocalSearchSolution(solution, value, hash, 100);
+
+    check(fresh.getEvaluations() > 100 && cached.getCacheHits() == 1, "cache: la bajada cortada se guarda");
+    check(reached[0] == solution && reached[1] == solution, "cache: el acierto es la bajada cortada");
+}
+
+// Formato binario: n, m, las distancias (exactas, son double) y las etiquetas vuelven tal cual. Un
+// fichero sin las etiquetas (como los de antes) se lee con las posiciones como etiquetas
+void binaryRoundTrip()
+{
+    shared_ptr<const Instance> full = Instance::generate(30, 6, EUCLIDEAN_DISTANCES, 8);
+    shared_ptr<const Instance> data = full->subset({29, 3, 17, 8, 22, 0, 11, 25, 14, 6});
+    string path = "/tmp/pruebasMDP_" + to_string(getpid()) + ".bin";
+
+    bool saved = data->save(path, true);
+    shared_ptr<const Instance> loaded = Instance::load(path);
+
+    bool same = saved && loaded && loaded->getN() == data->getN() && loaded->getM() == data->getM();
+    for(int i=0; same && i < data->getN(); i++){
+        same = loaded->getLabel(i) == data->getLabel(i);
+        for(int j=0; same && j < data->getN(); j++){
+            same = loaded->getDistance(i, j) == data->getDistance(i, j);
+        }
+    }
+    check(same, "binario: distancias y etiquetas tras guardar y leer");
+
+    bool truncated = truncate(path.c_str(), 12 + 45 * sizeof(double)) == 0;
+    shared_ptr<const Instance> old = Instance::load(path);
+    check(truncated && old && old->getLabel(9) == 9 && old->getDistance(0, 9) == data->getDistance(0, 9),
+          "binario: sin etiquetas se leen las posiciones");
+    remove(path.c_str());
+}
+
+// Instance::apply frente al problema construido de cero con la matriz ya cambiada (mismas etiquetas
+// en las mismas posiciones): mismas distancias y sumas, cotas exactas en los nombrados y cotas
+// superiores en el resto, y la misma solucion al resolver
+void applyMatchesRebuilt()
+{
+    shared_ptr<Instance> data = Instance::generate(20, 5, UNIFORM_DISTANCES, 6);
+    shared_ptr<const Instance> original = Instance::generate(20, 5, UNIFORM_DISTANCES, 6);
+
+    Delta delta;
+    delta.removed = {3, 7};
+    delta.added.push_back({25, {}});
+    for(int label=0; label < 20; label++){
+        if(label != 3 && label != 7){
+            delta.added[0].distances.push_back({label, 0.5 * label});
+        }
+    }
+    delta.changed = {{1, 2, 9.75}, {0, 25, 12.0}};
+
+    // Distancia esperada entre dos etiquetas tras el cambio
+    auto expected = [&](int a, int b){
+        for(const Delta::Change &change : delta.changed){
+            if((change.i == a && change.j == b) || (change.i == b && change.j == a)){
+                return change.distance;
+            }
+        }
+        if(a == 25 || b == 25){
+            return a == b ? 0.0 : 0.5 * (a == 25 ? b : a);
+        }
+        return original->getDistance(original->getPosition(a), original->getPosition(b));
+    };
+
+    bool applied = data->apply(delta);
+    int n = data->getN();
+    vector<int> labels(n);
+    vector<double> distances((size_t) n * n);
+    for(int i=0; i < n; i++){
+        labels[i] = data->getLabel(i);
+        for(int j=0; j < n; j++){
+            distances[(size_t) i * n + j] = expected(data->getLabel(i), data->getLabel(j));
+        }
+    }
+    shared_ptr<const Instance> rebuilt = make_shared<const Instance>(n, 5, distances, labels);
+
+    vector<int> named = delta.labels();
+    bool same = applied && n == 19 && data->getPosition(3) < 0 && data->getPosition(25) >= 0;
+    bool bounds = data->getUpperBound() >= rebuilt->getUpperBound() - 1e-9;
+    for(int i=0; same && i < n; i++){
+        for(int j=0; same && j < n; j++){
+            same = data->getDistance(i, j) == rebuilt->getDistance(i, j);
+        }
+        same = same && fabs(data->getRowSum(i) - rebuilt->getRowSum(i)) < 1e-9;
+
+        bool exact = find(named.begin(), named.end(), labels[i]) != named.end();
+        double bound = data->getContributionBound(i), fresh = rebuilt->getContributionBound(i);
+        bounds = bounds && (exact ? fabs(bound - fresh) < 1e-9 : bound >= fresh - 1e-9);
+    }
+    check(same, "apply: mismas distancias y sumas que el problema reconstruido");
+    check(bounds, "apply: cotas exactas en los cambiados y superiores en el resto");
+
+    Options options;
+    options.algorithm = EXHAUSTIVE;
+    Result incremental = Solver(data, options).solve(), scratch = Solver(rebuilt, options).solve();
+    check(incremental.value == scratch.value && incremental.solution == scratch.solution, "apply: misma solucion exacta");
+}
+
+// Ramificacion y poda MaxSum frente a la exhaustiva: mismo valor y mismo subconjunto, con uno y con
+// varios hilos y en las tres distribuciones (la agrupada tiene muchos casi empates)
+void branchAndBoundMatchesExhaustive()
+{
+    const vector<pair<Distribution, string>> distributions = {{UNIFORM_DISTANCES, "uniforme"}, {EUCLIDEAN_DISTANCES, "euclidea"},
+                                                              {CLUSTERED_DISTANCES, "agrupada"}};
+
+    for(const pair<Distribution, string> &distribution : distributions){
+        shared_ptr<const Instance> data = Instance::generate(20, 6, distribution.first, 12);
+
+        Options options;
+        options.algorithm = EXHAUSTIVE;
+        Result exact = Solver(data, options).solve();
+
+        for(int threads : {1, 3}){
+            options.algorithm = BRANCH_AND_BOUND;
+            options.threads = threads;
+            Result bb = Solver(data, options).solve();
+
+            check(bb.value == exact.value && bb.solution == exact.solution,
+                  "ramificacion y poda " + distribution.second + " con " + to_string(threads) + " hilos: la de la exhaustiva");
+        }
+    }
+}
+
+// Memetico: los hijos de cada generacion se cruzan en serie y se mejoran en paralelo con la busqueda
+// local, que no usa aleatorios, asi que el resultado (y las evaluaciones) no dependen de los hilos
+void memeticIndependentOfThreads()
+{
+    shared_ptr<const Instance> data = Instance::generate(60, 10, UNIFORM_DISTANCES, 13);
+
+    for(Objective objective : {MAX_SUM, MAX_MIN}){
+        Options options;
+        options.algorithm = MEMETIC;
+        options.objective = objective;
+        options.starts = 30;
+        options.seed = 5;
+        Result single = Solver(data, options).solve();
+
+        for(int threads : {2, 4}){
+            options.threads = threads;
+            Result split = Solver(data, options).solve();
+
+            string name = string("memetico ") + (objective == MAX_SUM ? "MaxSum" : "Max-Min") + " con " + to_string(threads) + " hilos";
+            check(split.value == single.value && split.solution == single.solution && split.evaluations == single.evaluations,
+                  name + ": el mismo resultado que con uno");
+        }
+    }
+}
+
+// Reenlazado de caminos: se hace tras la misma busqueda y solo cambia la mejor si la supera, asi que
+// nunca da un resultado peor que la misma ejecucion sin el
+void relinkingNeverWorse()
+{
+    shared_ptr<const Instance> data = Instance::generate(60, 8, UNIFORM_DISTANCES, 14);
+
+    for(Algorithm algorithm : {MULTI_START, ITERATED_LOCAL_SEARCH, ITERATED_SIM_ANNEALING}){
+        bool never = true;
+
+        for(unsigned int seed=0; seed < 6; seed++){
+            for(int threads : {1, 2}){
+                Options options;
+                options.algorithm = algorithm;
+                options.seed = seed;
+                options.threads = threads;
+                Result plain = Solver(data, options).solve();
+                options.relinking = true;
+                Result relinked = Solver(data, options).solve();
+
+                never = never && relinked.value >= plain.value;
+            }
+        }
+
+        string name = algorithm == MULTI_START ? "multiarranque" : algorithm == ITERATED_LOCAL_SEARCH ? "reiterada" : "reiterada con enfriamiento";
+        check(never, "reenlazado en la " + name + ": nunca peor que sin el");
+    }
+}
+
+int main()
+{
+    annealingMaxMinFromZero();
+    variableNeighborhoodWithoutOutsiders();
+    exhaustiveSplitAcrossThreads();
+    cacheHitMatchesFreshDescent();
+    cachedDescentTwice();
+    iteratedSearchHitsCache();
+    cachedTruncatedDescent();
+    profileKeepsStreamFormat();
+    parallelScanMatchesSerial();
+    reductionFinishes();
+    binaryRoundTrip();
+    applyMatchesRebuilt();
+    branchAndBoundMatchesExhaustive();
+    memeticIndependentOfThreads();
+    relinkingNeverWorse();
+
+    return failures > 0;
+}
@@ -0,0 +1,357 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make servidorMDP
+    Ejecutar: ./servidorMDP - [hilos]                 (trabajos por la entrada estandar)
+              ./servidorMDP /tmp/mdp.sock [hilos]     (trabajos por un socket Unix)
+    Fecha: 19/10/2026
+
+    Servidor que mantiene los problemas cargados en memoria y resuelve trabajos con un
+    conjunto de hilos. Cada trabajo es una linea de texto:
+
+        fichero algoritmo semilla [presupuesto]
+
+    algoritmo: busquedaLocal | busquedaMultiBasica | busquedaLocalReiterada |
+               busquedaLocalReiterada-ES | enfriamientoSimulado | greedy | exhaustiva |
+               exacta | algoritmoMemetico | busquedaVecindarioVariable
+    presupuesto: maximo de evaluaciones por busqueda (por defecto el de cada ejecutable)
+
+    Se mantienen cargados como mucho MAX_INSTANCES problemas: al pasar de ahi se descarta el que
+    lleva mas tiempo sin usarse (los trabajos que ya lo tienen terminan con el).
+
+    Por cada trabajo se responde una linea "num_trabajo\tvalor\ttiempo" en cuanto termina,
+    donde num_trabajo es el orden (desde 0) del trabajo dentro de la conexion.
+*/
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <queue>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+#define MAX_INSTANCES 16    // Problemas distintos que se mantienen cargados
+
+// Problema cargado (o cargandose) y fecha de modificacion del fichero cuando se leyo: si cambia se
+// vuelve a leer. Los trabajos que piden un problema mientras se lee esperan al mismo future. load
+// identifica la lectura y lastUse es el ultimo trabajo que lo pidio (para descartar el mas antiguo)
+struct loadedInstance
+{
+    shared_future<shared_ptr<const Instance>> data;
+    time_t mtime;
+    unsigned long long load, lastUse;
+};
+
+// Conjunto de hilos que ejecutan los trabajos encolados
+class workerPool
+{
+    private:
+    vector<thread> workers;
+    queue<function<void()>> jobs;
+    mutex mtx;
+    condition_variable cv;
+    bool stop;
+
+    public:
+    workerPool(int numThreads);
+    ~workerPool();
+
+    void submit(function<void()> job);
+};
+
+// Conexion por la que llegan trabajos y se devuelven resultados
+struct connection
+{
+    int fd_in, fd_out;
+
+    //Protege la escritura de respuestas y el contador de trabajos pendientes
+    mutex mtx;
+    condition_variable cv;
+    int pending;
+
+    connection(int in, int out):fd_in(in), fd_out(out), pending(0) {}
+
+    void send(const string &line);
+};
+
+//Problemas cargados, indexados por ruta del fichero, y peticiones hechas (marca de cada uso)
+map<string, loadedInstance> instances;
+unsigned long long instanceUses = 0;
+mutex instances_mtx;
+
+shared_ptr<const Instance> getInstance(const string &path);
+void solveJob(shared_ptr<connection> conn, int id, string path, string algorithm, unsigned int seed, int budget);
+void serve(shared_ptr<connection> conn, workerPool &pool);
+
+int main(int argc, char const *argv[])
+{
+    if(argc < 2){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    int numThreads = argc > 2 ? stoi(argv[2]) : (int) thread::hardware_concurrency();
+    if(numThreads < 1){
+        numThreads = 1;
+    }
+
+    // Un cliente que cierra la conexion no debe tumbar el servidor
+    signal(SIGPIPE, SIG_IGN);
+
+    workerPool pool(numThreads);
+    string path = argv[1];
+
+    // Trabajos por la entrada estandar: termina cuando se cierra la entrada y acaban todos
+    if(path == "-"){
+        serve(make_shared<connection>(STDIN_FILENO, STDOUT_FILENO), pool);
+        return 0;
+    }
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server < 0){
+        cout << "Error: No se puede crear el socket" << endl;
+        return 1;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(addr.sun_path)){
+        cout << "Error: Ruta del socket demasiado larga" << endl;
+        return 1;
+    }
+    path.copy(addr.sun_path, path.size());
+    unlink(path.c_str());
+
+    if(::bind(server, (sockaddr *) &addr, sizeof(addr)) < 0 || listen(server, 16) < 0){
+        cout << "Error: No se puede escuchar en " << path << endl;
+        return 1;
+    }
+
+    // Cada cliente tiene un hilo que lee sus trabajos; la resolucion la hacen los hilos del pool
+    while(true){
+        int client = accept(server, nullptr, nullptr);
+        if(client < 0){
+            continue;
+        }
+
+        thread([client, &pool](){
+            serve(make_shared<connection>(client, client), pool);
+            close(client);
+        }).detach();
+    }
+
+    return 0;
+}
+
+void serve(shared_ptr<connection> conn, workerPool &pool)
+{
+    string pending;
+    char buffer[4096];
+    int id = 0;
+    ssize_t bytes;
+
+    // Leemos lineas completas y encolamos un trabajo por cada una
+    while((bytes = read(conn->fd_in, buffer, sizeof(buffer))) > 0){
+        pending.append(buffer, bytes);
+
+        size_t end;
+        while((end = pending.find('\n')) != string::npos){
+            string line = pending.substr(0, end);
+            pending.erase(0, end + 1);
+
+            istringstream job(line);
+            string path, algorithm;
+            unsigned int seed;
+            int budget = 0;
+
+            // Lineas vacias o comentarios
+            if(!(job >> path) || path[0] == '#'){
+                continue;
+            }
+
+            if(!(job >> algorithm >> seed)){
+                conn->send(to_string(id++) + "\tError: Trabajo invalido");
+                continue;
+            }
+            job >> budget;
+
+            {
+                lock_guard<mutex> lock(conn->mtx);
+                conn->pending++;
+            }
+
+            int job_id = id++;
+            pool.submit([conn, job_id, path, algorithm, seed, budget](){
+                solveJob(conn, job_id, path, algorithm, seed, budget);
+            });
+        }
+    }
+
+    // Esperamos a responder todos los trabajos antes de cerrar la conexion
+    unique_lock<mutex> lock(conn->mtx);
+    conn->cv.wait(lock, [&conn](){ return conn->pending == 0; });
+}
+
+void solveJob(shared_ptr<connection> conn, int id, string path, string algorithm, unsigned int seed, int budget)
+{
+    ostringstream result;
+    result << id << "\t";
+
+    shared_ptr<const Instance> data = getInstance(path);
+    Options options;
+
+    if(!data){
+        result << "Error: No se puede leer " << path;
+    }else if(!parseAlgorithm(algorithm, options.algorithm)){
+        result << "Error: Algoritmo desconocido " << algorithm;
+    }else{
+        options.seed = seed;
+        options.budget = budget;
+
+        // Cada trabajo usa un hilo del pool; el problema cargado se comparte entre todos
+        Result solution = Solver(data, options).solve();
+
+        result << solution.value << "\t" << solution.microseconds;
+    }
+
+    conn->send(result.str());
+
+    lock_guard<mutex> lock(conn->mtx);
+    conn->pending--;
+    conn->cv.notify_all();
+}
+
+shared_ptr<const Instance> getInstance(const string &path)
+{
+    struct stat info;
+    if(stat(path.c_str(), &info) != 0){
+        return nullptr;
+    }
+
+    // El cerrojo solo protege el mapa: la lectura se hace fuera para no frenar los trabajos de otros problemas
+    promise<shared_ptr<const Instance>> loading;
+    shared_future<shared_ptr<const Instance>> loaded;
+    unsigned long long load = 0;
+    {
+        lock_guard<mutex> lock(instances_mtx);
+        unsigned long long use = ++instanceUses;
+
+        // Si ya esta cargado (o cargandose) y el fichero no ha cambiado lo reutilizamos; si ha cambiado
+        // la entrada nueva sustituye a la vieja
+        auto it = instances.find(path);
+        if(it != instances.end() && it->second.mtime == info.st_mtime){
+            loaded = it->second.data;
+            it->second.lastUse = use;
+        }else{
+            load = use;
+            instances[path] = {loading.get_future().share(), info.st_mtime, load, use};
+
+            // Con demasiados problemas se descarta el que lleva mas tiempo sin pedirse
+            if(instances.size() > MAX_INSTANCES){
+                auto oldest = instances.begin();
+                for(auto other = instances.begin(); other != instances.end(); other++){
+                    if(other->second.lastUse < oldest->second.lastUse){
+                        oldest = other;
+                    }
+                }
+                instances.erase(oldest);
+            }
+        }
+    }
+
+    if(loaded.valid()){
+        return loaded.get();
+    }
+
+    // Se guarda ya reetiquetado: los resultados siguen en las etiquetas del fichero
+    shared_ptr<const Instance> data = Instance::load(path);
+    if(data){
+        data = data->reorder();
+    }
+    loading.set_value(data);
+
+    // Si no se pudo leer no se recuerda, para volver a intentarlo en el siguiente trabajo (si la entrada
+    // sigue siendo la de esta lectura: se puede haber descartado y vuelto a pedir)
+    if(!data){
+        lock_guard<mutex> lock(instances_mtx);
+        auto it = instances.find(path);
+        if(it != instances.end() && it->second.load == load){
+            instances.erase(it);
+        }
+    }
+
+    return data;
+}
+
+void connection::send(const string &line)
+{
+    string out = line + "\n";
+
+    lock_guard<mutex> lock(mtx);
+    size_t sent = 0;
+    while(sent < out.size()){
+        ssize_t bytes = write(fd_out, out.data() + sent, out.size() - sent);
+        if(bytes <= 0){
+            break;
+        }
+        sent += bytes;
+    }
+}
+
+workerPool::workerPool(int numThreads):stop(false)
+{
+    for(int i=0; i<numThreads; i++){
+        workers.emplace_back([this](){
+            while(true){
+                function<void()> job;
+                {
+                    unique_lock<mutex> lock(mtx);
+                    cv.wait(lock, [this](){ return stop || !jobs.empty(); });
+                    if(stop && jobs.empty()){
+                        return;
+                    }
+                    job = move(jobs.front());
+                    jobs.pop();
+                }
+                job();
+            }
+        });
+    }
+}
+
+workerPool::~workerPool()
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+
+    for(thread &worker : workers){
+        worker.join();
+    }
+}
+
+void workerPool::submit(function<void()> job)
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        jobs.push(move(job));
+    }
+    cv.notify_one();
+}
+
@@ -0,0 +1,36 @@
+/*  Autor: Juan Miguel Gomez
+    Compilar: make trazaCSV
+    Ejecutar: ./trazaCSV traza.bin > traza.csv
+    Fecha: 19/10/2026
+
+    Pasa a CSV una traza binaria de las busquedas (--traza=fichero con libmdp compilada con
+    make TRACE=1): una linea "hilo,tiempo_us,evento,a,b,valor,extra" por registro
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mdp/mdp.h"
+
+using namespace std;
+using namespace mdp;
+
+int main(int argc, char const *argv[])
+{
+    if(argc < 2){
+        cout << "Error: Numero de argumentos invalido" << endl;
+        return 1;
+    }
+
+    long long dropped = exportTrace(argv[1], cout);
+    if(dropped < 0){
+        cerr << "Error: " << argv[1] << " no es un fichero de traza" << endl;
+        return 1;
+    }
+
+    if(dropped > 0){
+        cerr << "Aviso: se descartaron " << dropped << " registros al trazar (anillo lleno)" << endl;
+    }
+
+    return 0;
+}